@@ -0,0 +1,67 @@
+#include "BenchmarkRunner.h"
+
+#include <cstdio>
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QtGlobal>
+
+namespace {
+    volatile double gBenchmarkSink = 0.0;
+}
+
+void benchmarkSink(double value) {
+    gBenchmarkSink = gBenchmarkSink + value;
+}
+
+void BenchmarkRunner::record(const QString &name, const QJsonObject &params, qint64 elements,
+                             QVector<qint64> samples) {
+    std::sort(samples.begin(), samples.end());
+    qint64 total = 0;
+    for (const qint64 sample: std::as_const(samples)) {
+        total += sample;
+    }
+    const qint64 median = samples[samples.size() / 2];
+
+    QJsonObject result = params;
+    result["name"] = name;
+    result["elements"] = elements;
+    result["iterations"] = samples.size();
+    result["minNs"] = samples.first();
+    result["medianNs"] = median;
+    result["meanNs"] = static_cast<double>(total) / samples.size();
+    result["nsPerElement"] = elements > 0 ? static_cast<double>(median) / elements : 0.0;
+    mResults.append(result);
+
+    qInfo().noquote() << QString("%1 %2 n=%3 median=%4 ms (%5 ns/elem)")
+            .arg(name, -28)
+            .arg(QString::fromUtf8(QJsonDocument(params).toJson(QJsonDocument::Compact)), -52)
+            .arg(elements, 8)
+            .arg(median / 1.0e6, 9, 'f', 3)
+            .arg(result["nsPerElement"].toDouble(), 0, 'f', 2);
+}
+
+bool BenchmarkRunner::writeJson(const QString &filePath) const {
+    QJsonObject report;
+    report["qtVersion"] = qVersion();
+    report["cpu"] = QSysInfo::currentCpuArchitecture();
+#ifdef NDEBUG
+    report["build"] = "release";
+#else
+    report["build"] = "debug";
+#endif
+    report["results"] = mResults;
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    if (filePath.isEmpty()) {
+        std::fwrite(json.constData(), 1, json.size(), stdout);
+        return true;
+    }
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "BenchmarkRunner::writeJson - cannot open" << filePath;
+        return false;
+    }
+    return file.write(json) == json.size();
+}
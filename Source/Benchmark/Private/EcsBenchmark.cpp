@@ -0,0 +1,213 @@
+#include "EcsBenchmark.h"
+
+#include <memory>
+#include <random>
+
+#include "BenchmarkRunner.h"
+#include "Component/CameraControllerComponent.h"
+#include "Component/ComponentArray.h"
+#include "Component/LightComponent.h"
+#include "Component/RenderableComponent.h"
+#include "Component/TransformComponent.h"
+
+namespace {
+    QString storageName(World::StorageMode mode) {
+        return mode == World::StorageMode::Archetype ? "archetype" : "sparse";
+    }
+
+    QVector<EntityID> shuffled(QVector<EntityID> entities) {
+        std::mt19937 rng(1234);
+        std::shuffle(entities.begin(), entities.end(), rng);
+        return entities;
+    }
+
+    /*!
+     * 查询用的混合场景：全部实体有 Transform，1/2 有 Renderable，1/4 有 Light，1/8 有 CameraController
+     * 组件越多的查询命中越少，更接近真实场景里“少数实体带有特殊组件”的分布
+     */
+    void populateMixedWorld(World &world, qint32 count) {
+        const qint32 eighth = count / 8;
+        const qint32 quarter = count / 4;
+        const qint32 half = count / 2;
+        world.createEntities(eighth, TransformComponent{}, RenderableComponent{}, LightComponent{},
+                             CameraControllerComponent{});
+        world.createEntities(quarter - eighth, TransformComponent{}, RenderableComponent{}, LightComponent{});
+        world.createEntities(half - quarter, TransformComponent{}, RenderableComponent{});
+        world.createEntities(count - half, TransformComponent{});
+    }
+
+    // 各组件取一个标量参与求和，保证遍历结果被使用
+    float touch(const TransformComponent &transform) { return transform.scale().x(); }
+    float touch(const RenderableComponent &renderable) { return renderable.isVisible ? 1.0f : 0.0f; }
+    float touch(const LightComponent &light) { return light.intensity; }
+    float touch(const CameraControllerComponent &controller) { return controller.mMoveSpeed; }
+
+    template<typename... Ts>
+    void benchmarkQueries(BenchmarkRunner &runner, World &world, const QString &storage, qint32 count) {
+        const qint32 iterations = BenchmarkRunner::iterationsFor(count);
+        QJsonObject params{{"storage", storage}, {"entities", count}, {"components", qint32(sizeof...(Ts))}};
+
+        runner.measure("World.view", params, count, iterations, [&world] {
+            double sum = 0.0;
+            for (const EntityID entity: World::ViewIterator<Ts...>(&world)) {
+                sum += (touch(*world.getComponent<Ts>(entity)) + ...);
+            }
+            benchmarkSink(sum);
+        });
+
+        runner.measure("World.each", params, count, iterations, [&world] {
+            double sum = 0.0;
+            world.each<Ts...>([&sum](EntityID, Ts &... components) {
+                sum += (touch(components) + ...);
+            });
+            benchmarkSink(sum);
+        });
+
+        // 首次调用会建立 group 并填充成员，预热后只测量遍历
+        world.group<Ts...>();
+        runner.measure("World.group", params, count, iterations, [&world] {
+            double sum = 0.0;
+            for (const EntityID entity: world.group<Ts...>()) {
+                sum += (touch(*world.getComponent<Ts>(entity)) + ...);
+            }
+            benchmarkSink(sum);
+        });
+    }
+
+    void benchmarkComponentArray(BenchmarkRunner &runner, qint32 count) {
+        const qint32 iterations = BenchmarkRunner::iterationsFor(count);
+        const QJsonObject params{{"entities", count}};
+
+        QVector<EntityID> entities;
+        entities.reserve(count);
+        for (qint32 i = 0; i < count; ++i) {
+            entities.append(makeEntity(static_cast<quint32>(i + 1), 0));
+        }
+        const QVector<EntityID> randomOrder = shuffled(entities);
+
+        std::unique_ptr<ComponentArray<TransformComponent> > array;
+        runner.measure("ComponentArray.insert", params, count, iterations, [&array] {
+            array = std::make_unique<ComponentArray<TransformComponent> >();
+        }, [&] {
+            for (const EntityID entity: entities) {
+                array->insert(entity, TransformComponent{});
+            }
+        });
+
+        runner.measure("ComponentArray.get", params, count, iterations, [&] {
+            double sum = 0.0;
+            for (const EntityID entity: randomOrder) {
+                sum += touch(*array->get(entity));
+            }
+            benchmarkSink(sum);
+        });
+
+        runner.measure("ComponentArray.remove", params, count, iterations, [&] {
+            array = std::make_unique<ComponentArray<TransformComponent> >();
+            for (const EntityID entity: entities) {
+                array->insert(entity, TransformComponent{});
+            }
+        }, [&] {
+            for (const EntityID entity: randomOrder) {
+                array->remove(entity);
+            }
+        });
+    }
+
+    void benchmarkWorldAccess(BenchmarkRunner &runner, World::StorageMode mode, qint32 count) {
+        const qint32 iterations = BenchmarkRunner::iterationsFor(count);
+        const QJsonObject params{{"storage", storageName(mode)}, {"entities", count}};
+
+        std::unique_ptr<World> world;
+        QVector<EntityID> entities;
+        runner.measure("World.addComponent", params, count, iterations, [&] {
+            world = std::make_unique<World>(mode);
+            entities.clear();
+            entities.reserve(count);
+            for (qint32 i = 0; i < count; ++i) {
+                entities.append(world->createEntity());
+            }
+        }, [&] {
+            for (const EntityID entity: std::as_const(entities)) {
+                world->addComponent(entity, TransformComponent{});
+            }
+        });
+
+        // 一半实体带 Renderable，hasComponent 命中和未命中各占一半
+        for (qint32 i = 0; i < count; i += 2) {
+            world->addComponent(entities[i], RenderableComponent{});
+        }
+        const QVector<EntityID> randomOrder = shuffled(entities);
+
+        runner.measure("World.getComponent", params, count, iterations, [&] {
+            double sum = 0.0;
+            for (const EntityID entity: randomOrder) {
+                sum += touch(*world->getComponent<TransformComponent>(entity));
+            }
+            benchmarkSink(sum);
+        });
+
+        runner.measure("World.hasComponent", params, count, iterations, [&] {
+            qint32 hits = 0;
+            for (const EntityID entity: randomOrder) {
+                hits += world->hasComponent<RenderableComponent>(entity) ? 1 : 0;
+            }
+            benchmarkSink(hits);
+        });
+
+        runner.measure("World.createEntities", params, count, iterations, [&] {
+            world = std::make_unique<World>(mode);
+        }, [&] {
+            benchmarkSink(world->createEntities(count, TransformComponent{}, RenderableComponent{}).size());
+        });
+    }
+
+    // 反复销毁随机一半实体再重建，覆盖槽位复用和组件存储的 swap-remove
+    void benchmarkChurn(BenchmarkRunner &runner, World::StorageMode mode, qint32 count) {
+        constexpr qint32 Rounds = 4;
+        const qint32 iterations = BenchmarkRunner::iterationsFor(count);
+        const QJsonObject params{{"storage", storageName(mode)}, {"entities", count}, {"rounds", Rounds}};
+
+        std::unique_ptr<World> world;
+        QVector<EntityID> entities;
+        std::mt19937 rng(42);
+        runner.measure("World.destroyEntity.churn", params, static_cast<qint64>(count / 2) * Rounds, iterations, [&] {
+            world = std::make_unique<World>(mode);
+            entities = world->createEntities(count, TransformComponent{}, RenderableComponent{});
+        }, [&] {
+            for (qint32 round = 0; round < Rounds; ++round) {
+                std::shuffle(entities.begin(), entities.end(), rng);
+                const qint32 half = count / 2;
+                for (qint32 i = 0; i < half; ++i) {
+                    world->destroyEntity(entities[i]);
+                }
+                for (qint32 i = 0; i < half; ++i) {
+                    const EntityID entity = world->createEntity();
+                    world->addComponent(entity, TransformComponent{});
+                    world->addComponent(entity, RenderableComponent{});
+                    entities[i] = entity;
+                }
+            }
+        });
+    }
+}
+
+void runEcsBenchmarks(BenchmarkRunner &runner, const EcsBenchmarkOptions &options) {
+    for (const qint32 count: options.entityCounts) {
+        benchmarkComponentArray(runner, count);
+
+        for (const World::StorageMode mode: options.storageModes) {
+            const QString storage = storageName(mode);
+            benchmarkWorldAccess(runner, mode, count);
+            benchmarkChurn(runner, mode, count);
+
+            World world(mode);
+            populateMixedWorld(world, count);
+            benchmarkQueries<TransformComponent>(runner, world, storage, count);
+            benchmarkQueries<TransformComponent, RenderableComponent>(runner, world, storage, count);
+            benchmarkQueries<TransformComponent, RenderableComponent, LightComponent>(runner, world, storage, count);
+            benchmarkQueries<TransformComponent, RenderableComponent, LightComponent, CameraControllerComponent>(
+                runner, world, storage, count);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#include "TransformBenchmark.h"
+
+#include <random>
+
+#include "BenchmarkRunner.h"
+#include "CommonRender.h"
+#include "Component/TransformComponent.h"
+#include "Scene/JobSystem.h"
+#include "Scene/TransformSoA.h"
+
+namespace {
+    QVector<TransformComponent> randomTransforms(qint32 count) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+        QVector<TransformComponent> transforms(count);
+        for (TransformComponent &transform: transforms) {
+            transform.setPosition({position(rng), position(rng), position(rng)});
+            const QVector3D axis = QVector3D(position(rng), position(rng), position(rng)).normalized();
+            transform.setRotation(QQuaternion::fromAxisAndAngle(axis, angle(rng)));
+            transform.setScale({scale(rng), scale(rng), scale(rng)});
+        }
+        return transforms;
+    }
+
+    double maxAbsDifference(const QVector<InstanceUniformBlock> &a, const QVector<InstanceUniformBlock> &b) {
+        double maxDiff = 0.0;
+        for (qint32 i = 0; i < a.size(); ++i) {
+            for (qint32 k = 0; k < 16; ++k) {
+                maxDiff = qMax(maxDiff, static_cast<double>(qAbs(a[i].model.constData()[k] - b[i].model.constData()[k])));
+            }
+        }
+        return maxDiff;
+    }
+}
+
+void runTransformBenchmarks(BenchmarkRunner &runner, const QVector<qint32> &transformCounts) {
+    for (const qint32 count: transformCounts) {
+        const qint32 iterations = BenchmarkRunner::iterationsFor(count);
+        const QVector<TransformComponent> transforms = randomTransforms(count);
+        TransformSoA soa;
+        soa.reserve(count);
+        for (const TransformComponent &transform: transforms) {
+            soa.append(transform);
+        }
+
+        QVector<InstanceUniformBlock> perEntity(count);
+        QVector<InstanceUniformBlock> batched(count);
+
+        runner.measure("Transform.localMatrix", {{"entities", count}}, count, iterations, [&] {
+            InstanceUniformBlock *instances = perEntity.data();
+            for (qint32 i = 0; i < count; ++i) {
+                instances[i].model = transforms[i].localMatrix().toGenericMatrix<4, 4>();
+            }
+            benchmarkSink(instances[count - 1].model.constData()[12]);
+        });
+
+        // 两条路径的结果应当一致，误差写进结果里便于核对
+        soa.composeMatrices(0, count, batched.data(), sizeof(InstanceUniformBlock));
+        const QJsonObject params{
+            {"entities", count}, {"kernel", TransformSoA::kernelName()},
+            {"maxAbsError", maxAbsDifference(perEntity, batched)}
+        };
+
+        runner.measure("TransformSoA.composeMatrices", params, count, iterations, [&] {
+            soa.composeMatrices(0, count, batched.data(), sizeof(InstanceUniformBlock));
+            benchmarkSink(batched[count - 1].model.constData()[12]);
+        });
+
+        runner.measure("TransformSoA.composeMatrices.parallel", params, count, iterations, [&] {
+            InstanceUniformBlock *instances = batched.data();
+            JobSystem::getInstance()->parallelFor(count, 4096, [&](qint32 begin, qint32 end) {
+                soa.composeMatrices(begin, end, instances + begin, sizeof(InstanceUniformBlock));
+            });
+            benchmarkSink(instances[count - 1].model.constData()[12]);
+        });
+    }
+}
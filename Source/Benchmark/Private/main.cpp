@@ -0,0 +1,56 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include "BenchmarkRunner.h"
+#include "EcsBenchmark.h"
+#include "TransformBenchmark.h"
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("Benchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("ECS and transform micro-benchmarks, results are written as JSON");
+    parser.addHelpOption();
+    const QCommandLineOption outputOption({"o", "output"}, "Write the JSON report to <file> instead of stdout.", "file");
+    const QCommandLineOption maxEntitiesOption("max-entities", "Skip entity counts above <count>.", "count");
+    const QCommandLineOption storageOption("storage", "Storage mode to run: sparse, archetype or both (default).",
+                                           "mode", "both");
+    const QCommandLineOption suiteOption("suite", "Benchmark suite to run: ecs, transform or all (default).",
+                                         "suite", "all");
+    parser.addOption(outputOption);
+    parser.addOption(maxEntitiesOption);
+    parser.addOption(storageOption);
+    parser.addOption(suiteOption);
+    parser.process(app);
+
+    EcsBenchmarkOptions options;
+    if (parser.isSet(maxEntitiesOption)) {
+        const qint32 maxEntities = parser.value(maxEntitiesOption).toInt();
+        options.entityCounts.removeIf([maxEntities](qint32 count) { return count > maxEntities; });
+    }
+    const QString storage = parser.value(storageOption);
+    if (storage == "sparse") {
+        options.storageModes = {World::StorageMode::SparseSet};
+    } else if (storage == "archetype") {
+        options.storageModes = {World::StorageMode::Archetype};
+    } else if (storage != "both") {
+        qCritical() << "Unknown storage mode:" << storage;
+        return 1;
+    }
+
+    const QString suite = parser.value(suiteOption);
+    if (suite != "all" && suite != "ecs" && suite != "transform") {
+        qCritical() << "Unknown suite:" << suite;
+        return 1;
+    }
+
+    BenchmarkRunner runner;
+    if (suite != "transform") {
+        runEcsBenchmarks(runner, options);
+    }
+    if (suite != "ecs") {
+        runTransformBenchmarks(runner, options.entityCounts);
+    }
+    return runner.writeJson(parser.value(outputOption)) ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+/*!
+ * 基准测试的计时与结果收集
+ * 每个用例重复 iterations 次，每次先执行不计时的 setup，再只对 run 计时；结果按 JSON 数组收集
+ * @note 结果里同时给出最小值和中位数，比较不同提交时优先看中位数，最小值用来排除调度抖动
+ */
+class BenchmarkRunner {
+public:
+    /**
+     * @brief 运行一个用例并记录结果。
+     * @param params 写入结果的附加字段，例如存储模式、组件数
+     * @param elements 每次 run 处理的元素个数，用来换算每元素耗时
+     */
+    template<typename Setup, typename Run>
+    void measure(const QString &name, const QJsonObject &params, qint64 elements, qint32 iterations,
+                 Setup &&setup, Run &&run) {
+        QVector<qint64> samples;
+        samples.reserve(iterations);
+        QElapsedTimer timer;
+        for (qint32 i = 0; i < iterations; ++i) {
+            setup();
+            timer.start();
+            run();
+            samples.append(timer.nsecsElapsed());
+        }
+        record(name, params, elements, std::move(samples));
+    }
+
+    // 没有 setup 的用例
+    template<typename Run>
+    void measure(const QString &name, const QJsonObject &params, qint64 elements, qint32 iterations, Run &&run) {
+        measure(name, params, elements, iterations, [] {
+        }, std::forward<Run>(run));
+    }
+
+    // 按元素个数给出重复次数：小规模多跑几次降低噪声，百万级只跑几次
+    static qint32 iterationsFor(qint64 elements) {
+        return static_cast<qint32>(std::clamp<qint64>(2'000'000 / qMax<qint64>(1, elements), 5, 50));
+    }
+
+    const QJsonArray &results() const { return mResults; }
+
+    /**
+     * @brief 写出 JSON 报告。
+     * @param filePath 为空时写到标准输出
+     */
+    bool writeJson(const QString &filePath) const;
+
+private:
+    void record(const QString &name, const QJsonObject &params, qint64 elements, QVector<qint64> samples);
+
+    QJsonArray mResults;
+};
+
+// 防止被测代码被优化掉
+void benchmarkSink(double value);
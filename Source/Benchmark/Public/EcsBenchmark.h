@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QVector>
+
+#include "Scene/World.h"
+
+class BenchmarkRunner;
+
+struct EcsBenchmarkOptions {
+    QVector<qint32> entityCounts{1'000, 10'000, 100'000, 1'000'000};
+    QVector<World::StorageMode> storageModes{World::StorageMode::SparseSet, World::StorageMode::Archetype};
+};
+
+/**
+ * @brief ECS 热路径基准：ComponentArray 的增删查、World 的组件读写、1~4 组件的 view/each 遍历和实体销毁重建。
+ */
+void runEcsBenchmarks(BenchmarkRunner &runner, const EcsBenchmarkOptions &options);
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <QVector>
+
+class BenchmarkRunner;
+
+/**
+ * @brief 实例矩阵合成基准：逐实体 TransformComponent::localMatrix() 与 TransformSoA 批量内核对比，都写入实例上传缓冲区布局。
+ */
+void runTransformBenchmarks(BenchmarkRunner &runner, const QVector<qint32> &transformCounts);
@@ -25,6 +25,7 @@ const quint32 BINDING_NORMAL_MAP = 4;
 const quint32 BINDING_METALROUGH_MAP = 5;
 const quint32 BINDING_AO_MAP = 6;
 const quint32 BINDING_EMISSIVE_MAP = 7;
+const quint32 BINDING_INSTANCE_NORMAL_UBO = 8;
 
 // --- UBO Structures ---
 
@@ -83,6 +84,12 @@ struct InstanceUniformBlock {
     QGenericMatrix<4, 4, float> model;
 };
 
+// 与 InstanceUniformBlock 一一对应的法线矩阵，单独一个 UBO 以免单个绑定区间超过 64KB
+// std140 下 mat3 数组步长为 48，与 model 的偏移对齐规则不一致，这里按 mat4 存放，只用左上 3x3
+struct InstanceNormalUniformBlock {
+    QGenericMatrix<4, 4, float> normalMatrix;
+};
+
 // --- Vertex Data ---
 
 struct VertexData {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <typeindex>
 #include <type_traits>
 #include <QtTypes>
@@ -7,13 +8,72 @@
 class Component;
 class System;
 
-using EntityID = quint32;
+/*!
+ * 实体句柄：低 32 位是槽位下标，高 32 位是代数(generation)
+ * 槽位被销毁后会回收复用，代数随之递增，旧句柄因代数不匹配而失效
+ * @note 下标 0 保留不用，因此 INVALID_ENTITY(0) 永远不会是有效句柄
+ */
+using EntityID = quint64;
 constexpr EntityID INVALID_ENTITY = 0;
 
+constexpr quint32 entityIndex(EntityID entity) noexcept {
+    return static_cast<quint32>(entity & 0xFFFFFFFFull);
+}
+
+constexpr quint32 entityGeneration(EntityID entity) noexcept {
+    return static_cast<quint32>(entity >> 32);
+}
+
+constexpr EntityID makeEntity(quint32 index, quint32 generation) noexcept {
+    return (static_cast<EntityID>(generation) << 32) | index;
+}
+
+// WorldCommandBuffer 中尚未真正创建的实体使用这个代数，World 不会分配它
+constexpr quint32 PENDING_ENTITY_GENERATION = 0xFFFFFFFFu;
+
+constexpr bool isPendingEntity(EntityID entity) noexcept {
+    return entityGeneration(entity) == PENDING_ENTITY_GENERATION;
+}
+
 using SystemTypeID = std::type_index;
-using ComponentTypeID = std::type_index;
+/*!
+ * 组件类型 ID：每种组件首次使用时分配的稠密整数，World 以它直接索引组件数组
+ * @note 分配顺序取决于首次使用的顺序，不同进程之间不稳定，不能写进存档
+ */
+using ComponentTypeID = quint32;
 
 namespace Internal {
+    inline quint32 nextDenseTypeID(std::atomic<quint32> &counter) noexcept {
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline std::atomic<quint32> &componentTypeCounter() noexcept {
+        static std::atomic<quint32> counter{0};
+        return counter;
+    }
+
+    inline std::atomic<quint32> &queryTypeCounter() noexcept {
+        static std::atomic<quint32> counter{0};
+        return counter;
+    }
+
+    template<typename T>
+    struct ComponentTypeIDGenerator {
+        static ComponentTypeID get() noexcept {
+            static const ComponentTypeID id = nextDenseTypeID(componentTypeCounter());
+            return id;
+        }
+    };
+
+    // 每种组件组合（例如 World::group<Ts...>）一个稠密 ID
+    template<typename... Ts>
+    struct QueryIDGenerator {
+        static quint32 get() noexcept {
+            static const quint32 id = nextDenseTypeID(queryTypeCounter());
+            return id;
+        }
+    };
+
     template<typename T>
     struct SystemTypeIDGenerator {
         static SystemTypeID get() noexcept {
@@ -28,7 +88,12 @@ template<typename T>
 inline ComponentTypeID getComponentTypeID() noexcept {
     static_assert(std::is_base_of_v<Component, T>,
                   "T must inherit from Component");
-    return typeid(T);
+    return Internal::ComponentTypeIDGenerator<std::remove_cv_t<T> >::get();
+}
+
+// 已分配的组件类型数量，所有 ComponentTypeID 都小于该值
+inline quint32 componentTypeCount() noexcept {
+    return Internal::componentTypeCounter().load(std::memory_order_relaxed);
 }
 
 template<typename T>
@@ -8,6 +8,7 @@
 #include <io/qdir.h>
 
 #include "CommonRender.h"
+#include "Component/HierarchyComponent.h"
 #include "Component/MaterialComponent.h"
 #include "Component/MeshComponent.h"
 #include "Component/RenderableComponent.h"
@@ -15,6 +16,29 @@
 #include "Resources/ResourceManager.h"
 #include "Scene/World.h"
 
+namespace {
+    // 把节点矩阵拆成 TRS；父子关系由 HierarchyComponent 表达，节点只保存相对父节点的变换
+    TransformComponent decomposeTransform(const QMatrix4x4 &matrix) {
+        QVector3D axisX = matrix.column(0).toVector3D();
+        const QVector3D axisY = matrix.column(1).toVector3D();
+        const QVector3D axisZ = matrix.column(2).toVector3D();
+        QVector3D scale(axisX.length(), axisY.length(), axisZ.length());
+        // 镜像变换把负号放到 X 缩放上，剩下的部分才是合法的旋转
+        if (QVector3D::dotProduct(QVector3D::crossProduct(axisX, axisY), axisZ) < 0.0f) {
+            scale.setX(-scale.x());
+            axisX = -axisX;
+        }
+
+        TransformComponent transform;
+        transform.setPosition(matrix.column(3).toVector3D());
+        transform.setScale(scale);
+        if (!qFuzzyIsNull(scale.x()) && !qFuzzyIsNull(scale.y()) && !qFuzzyIsNull(scale.z())) {
+            transform.setRotation(QQuaternion::fromAxes(axisX / qAbs(scale.x()), axisY / scale.y(), axisZ / scale.z()));
+        }
+        return transform;
+    }
+}
+
 ModelImporter::ModelImporter(QSharedPointer<World> world, QSharedPointer<ResourceManager> resourceManager,
                              QObject *parent)
     : QObject(parent), mWorld(world), mResourceManager(resourceManager) {
@@ -78,46 +102,25 @@ void ModelImporter::processNode(aiNode *node, const aiScene *scene, const QStrin
             "children";
 
     EntityID currentNodeEntity = parentEntity;
-    bool createdNodeEntity = false;
     if (node->mNumMeshes > 0 || node->mNumChildren > 0) {
+        const TransformComponent localTransform = decomposeTransform(aiMatrix4x4ToQMatrix4x4(node->mTransformation));
         if (node != scene->mRootNode) {
-            currentNodeEntity = mWorld->createEntity();
-            createdNodeEntity = true;
-            mWorld->addComponent<TransformComponent>(currentNodeEntity, {});
+            currentNodeEntity = mWorld->createEntity(localTransform,
+                                                     RenderableComponent{{}, node->mNumMeshes > 0},
+                                                     HierarchyComponent{{}, parentEntity});
             // mWorld->addComponent<NameComponent>(currentNodeEntity, {nodeName});
-            mWorld->addComponent<RenderableComponent>(currentNodeEntity, {{}, node->mNumMeshes > 0});
-
-            TransformComponent *tf = mWorld->getComponent<TransformComponent>(currentNodeEntity);
-            if (tf) {
-                QMatrix4x4 localTransform = aiMatrix4x4ToQMatrix4x4(node->mTransformation);
-                tf->setPosition(localTransform.column(3).toVector3D());
-                QQuaternion rotation = QQuaternion::fromRotationMatrix(localTransform.normalMatrix());
-                tf->setRotation(rotation);
-            }
-            // TODO: 添加父节点组件连接 Node 实体
-        } else {
-            TransformComponent *tf = mWorld->getComponent<TransformComponent>(currentNodeEntity);
-            if (tf) {
-                QMatrix4x4 localTransform = aiMatrix4x4ToQMatrix4x4(node->mTransformation);
-                tf->setPosition(localTransform.column(3).toVector3D());
-            }
+        } else if (TransformComponent *tf = mWorld->getMutableComponent<TransformComponent>(currentNodeEntity)) {
+            *tf = localTransform;
         }
     }
 
+    // 网格实体挂在所属节点下，自身保持单位变换，移动节点时由 TransformSystem 传播
     for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
         aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
         EntityID meshEntity = processMesh(mesh, scene, modelDir, nodeTransform,
                                           nodeName + "_mesh_" + QString::number(i));
         if (meshEntity != INVALID_ENTITY) {
-            if (createdNodeEntity) {
-                // TODO: 添加父节点组件连接 Node 实体
-            }
-            TransformComponent *meshTf = mWorld->getComponent<TransformComponent>(meshEntity);
-            if (meshTf) {
-                meshTf->setPosition(nodeTransform.column(3).toVector3D());
-                QQuaternion rot = QQuaternion::fromRotationMatrix(nodeTransform.normalMatrix());
-                meshTf->setRotation(rot);
-            }
+            mWorld->addComponent(meshEntity, HierarchyComponent{{}, currentNodeEntity});
         }
     }
 
@@ -183,7 +186,6 @@ EntityID ModelImporter::processMesh(aiMesh *mesh, const aiScene *scene, const QS
     }
 
     // --- 创建实体组件 ---
-    EntityID entity = mWorld->createEntity();
     // mWorld->addComponent<NameComponent>(entity, {baseName});
 
     // --- Mesh Component ---
@@ -191,7 +193,8 @@ EntityID ModelImporter::processMesh(aiMesh *mesh, const aiScene *scene, const QS
     mResourceManager->loadMeshFromData(meshResourceId, vertices, indices);
     MeshComponent meshComp;
     meshComp.meshResourceId = meshResourceId;
-    mWorld->addComponent<MeshComponent>(entity, meshComp);
+    // 上传后 ResourceManager 会释放它那份源数据，CPU 副本放进 GeometryArena 供场景快照保存导入的几何体
+    meshComp.geometry = GeometryArena::getInstance()->allocate(vertices, indices);
 
     // --- Material Component ---
     MaterialComponent matComp;
@@ -302,9 +305,8 @@ EntityID ModelImporter::processMesh(aiMesh *mesh, const aiScene *scene, const QS
     } else {
         qDebug() << "ProcessMesh: Material already cached:" << materialCacheKey;
     }
-    mWorld->addComponent<MaterialComponent>(entity, matComp);
-    mWorld->addComponent<TransformComponent>(entity, {});
-    mWorld->addComponent<RenderableComponent>(entity, {{}, true});
+    // 组件一次放到位，Archetype 模式下不必在中间签名之间搬移
+    EntityID entity = mWorld->createEntity(meshComp, matComp, TransformComponent{}, RenderableComponent{{}, true});
 
     return entity;
 }
@@ -29,7 +29,7 @@ void LightEditor::setCurrentObject(EntityID objId) {
 void LightEditor::updateLightProperties() {
     if (mUpdatingUI || mCurrentObjId == INVALID_ENTITY || !mWorld) return;
 
-    LightComponent *lc = mWorld->getComponent<LightComponent>(mCurrentObjId);
+    LightComponent *lc = mWorld->getMutableComponent<LightComponent>(mCurrentObjId);
     if (!lc) return;
 
     switch (lc->type) {
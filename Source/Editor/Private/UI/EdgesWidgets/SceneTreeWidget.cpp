@@ -13,12 +13,43 @@ SceneTreeWidget::SceneTreeWidget(QWidget *parent)
     connect(this, &QTreeWidget::itemSelectionChanged, this, &SceneTreeWidget::handleSelectionChanged);
 }
 
+SceneTreeWidget::~SceneTreeWidget() {
+    detachWorld();
+}
+
 void SceneTreeWidget::setWorld(QSharedPointer<World> world) {
+    detachWorld();
     mWorld = world;
+    if (!mWorld) return;
+
+    // 场景树只关心这三种组件的增删，以及可见性和灯光类型的修改
+    auto schedule = [this](World &, EntityID entity) { scheduleEntityUpdate(entity); };
+    mObserverIds = {
+        mWorld->onAdd<RenderableComponent>(schedule),
+        mWorld->onRemove<RenderableComponent>(schedule),
+        mWorld->onChange<RenderableComponent>(schedule),
+        mWorld->onAdd<LightComponent>(schedule),
+        mWorld->onRemove<LightComponent>(schedule),
+        mWorld->onChange<LightComponent>(schedule),
+        mWorld->onAdd<TransformComponent>(schedule),
+        mWorld->onRemove<TransformComponent>(schedule)
+    };
+}
+
+void SceneTreeWidget::detachWorld() {
+    if (mWorld) {
+        for (const World::ObserverID id: std::as_const(mObserverIds)) {
+            mWorld->removeObserver(id);
+        }
+    }
+    mObserverIds.clear();
+    mPendingEntities.clear();
 }
 
 void SceneTreeWidget::refreshSceneTree() {
     clear();
+    mItemByEntity.clear();
+    mPendingEntities.clear();
     if (!mWorld) {
         qWarning("SceneTreeWidget::refreshSceneTree - World is not set.");
         return;
@@ -27,31 +58,46 @@ void SceneTreeWidget::refreshSceneTree() {
     blockSignals(true);
     clearSelection();
 
-    QHash<EntityID, QTreeWidgetItem *> entityItemMap;
-
-    for (EntityID entity: mWorld->view<RenderableComponent, TransformComponent>()) {
-        auto *rc = mWorld->getComponent<RenderableComponent>(entity);
-        if (rc && rc->isVisible) {
-            auto *item = new QTreeWidgetItem(this);
-
-            item->setText(0, QString("Entity (ID: %1)").arg(entity));
+    for (EntityID entity: mWorld->group<RenderableComponent, TransformComponent>()) {
+        syncEntityItem(entity);
+    }
+    for (EntityID entity: mWorld->group<LightComponent, TransformComponent>()) {
+        syncEntityItem(entity);
+    }
 
-            item->setData(0, Qt::UserRole, QVariant::fromValue(entity));
+    blockSignals(false);
+    qDebug() << "Scene tree refreshed with" << topLevelItemCount() << "items.";
+}
 
-            addTopLevelItem(item);
-            entityItemMap[entity] = item;
-        }
+void SceneTreeWidget::scheduleEntityUpdate(EntityID entity) {
+    mPendingEntities.insert(entity);
+    // 观察者回调时组件可能还没全部就位（例如 onRemove 在移除之前触发），延后到事件循环里统一同步
+    if (!mFlushQueued) {
+        mFlushQueued = true;
+        QMetaObject::invokeMethod(this, &SceneTreeWidget::flushPendingEntities, Qt::QueuedConnection);
     }
+}
 
-    for (EntityID entity: mWorld->view<LightComponent, TransformComponent>()) {
-        if (entityItemMap.contains(entity)) {
-            continue;
-        }
+void SceneTreeWidget::flushPendingEntities() {
+    mFlushQueued = false;
+    if (!mWorld || mPendingEntities.isEmpty()) return;
 
-        auto *lc = mWorld->getComponent<LightComponent>(entity);
-        if (lc) {
-            auto *item = new QTreeWidgetItem();
+    blockSignals(true);
+    for (EntityID entity: std::as_const(mPendingEntities)) {
+        syncEntityItem(entity);
+    }
+    blockSignals(false);
+    mPendingEntities.clear();
+}
 
+void SceneTreeWidget::syncEntityItem(EntityID entity) {
+    QString label;
+    if (mWorld->hasComponent<TransformComponent>(entity)) {
+        const auto *rc = mWorld->getComponent<RenderableComponent>(entity);
+        const auto *lc = mWorld->getComponent<LightComponent>(entity);
+        if (rc && rc->isVisible) {
+            label = QString("Entity (ID: %1)").arg(entity);
+        } else if (lc) {
             QString typeStr;
             switch (lc->type) {
                 case LightType::Point:
@@ -61,17 +107,24 @@ void SceneTreeWidget::refreshSceneTree() {
                     typeStr = "Directional Light";
                     break;
             }
-            item->setText(0, QString("%1 (ID: %2)").arg(typeStr).arg(entity));
-
-            item->setData(0, Qt::UserRole, QVariant::fromValue(entity));
-
-            addTopLevelItem(item);
-            entityItemMap[entity] = item;
+            label = QString("%1 (ID: %2)").arg(typeStr).arg(entity);
         }
     }
 
-    blockSignals(false);
-    qDebug() << "Scene tree refreshed with" << topLevelItemCount() << "items.";
+    QTreeWidgetItem *item = mItemByEntity.value(entity, nullptr);
+    if (label.isEmpty()) {
+        if (item) {
+            mItemByEntity.remove(entity);
+            delete item;
+        }
+        return;
+    }
+    if (!item) {
+        item = new QTreeWidgetItem(this);
+        item->setData(0, Qt::UserRole, QVariant::fromValue(entity));
+        mItemByEntity.insert(entity, item);
+    }
+    item->setText(0, label);
 }
 
 void SceneTreeWidget::handleSelectionChanged() {
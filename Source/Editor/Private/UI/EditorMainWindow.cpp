@@ -11,10 +11,12 @@
 #include "Component/MaterialComponent.h"
 #include "Component/MeshComponent.h"
 #include "Component/RenderableComponent.h"
+#include "Component/SingletonComponents.h"
 #include "Component/TransformComponent.h"
 #include "Resources/ResourceManager.h"
 #include "Scene/ModelImporter.h"
 #include "Scene/World.h"
+#include "Scene/WorldSnapshot.h"
 #include "UI/EdgesWidgets/EditorStatusBar.h"
 #include "UI/EdgesWidgets/EditorToolBar.h"
 #include "UI/EdgesWidgets/EditorDockWidget.h"
@@ -51,6 +53,8 @@ EditorMainWindow::EditorMainWindow(QWidget *parent) : QMainWindow(parent) {
 
     connect(ObjectImportAction, &QAction::triggered, this, &EditorMainWindow::onImportModel);
     connect(CreateCubeAction, &QAction::triggered, this, &EditorMainWindow::onCreateCube);
+    connect(SaveSceneAction, &QAction::triggered, this, &EditorMainWindow::onSaveScene);
+    connect(OpenSceneAction, &QAction::triggered, this, &EditorMainWindow::onOpenScene);
     connect(CreateSphereAction, &QAction::triggered, this, &EditorMainWindow::onCreateSphere);
     connect(CreatePointLightAction, &QAction::triggered, this, &EditorMainWindow::onCreatePointLight);
     connect(CreateDirectionalLightAction, &QAction::triggered, this, &EditorMainWindow::onCreateDirectionalLight);
@@ -121,10 +125,8 @@ void EditorMainWindow::onImportModel() {
 }
 
 void EditorMainWindow::onModelImported() {
-    qInfo("Model import successful, refreshing scene tree.");
-    if (SceneTree) {
-        SceneTree->refreshSceneTree();
-    }
+    // 场景树通过 World 观察者自行同步新实体
+    qInfo("Model import successful.");
     if (ObjectTransformEditor) ObjectTransformEditor->setCurrentObject(INVALID_ENTITY);
     if (ObjectTextureEditor) ObjectTextureEditor->setCurrentObject(INVALID_ENTITY);
 }
@@ -134,6 +136,40 @@ void EditorMainWindow::onImportFailed(const QString &error) {
     QMessageBox::critical(this, tr("Import Error"), tr("Failed to import model:\n%1").arg(error));
 }
 
+void EditorMainWindow::onSaveScene() {
+    if (!mWorld) return;
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Save Scene"), "", tr("Scene Snapshot (*.qtrs)"));
+    if (filePath.isEmpty()) return;
+    if (!WorldSnapshot::getInstance()->saveToFile(*mWorld, filePath)) {
+        QMessageBox::critical(this, tr("Save Error"), tr("Failed to save scene:\n%1").arg(filePath));
+    }
+}
+
+void EditorMainWindow::onOpenScene() {
+    if (!mWorld || !mResourceManager) return;
+    QString filePath = QFileDialog::getOpenFileName(this, tr("Open Scene"), "", tr("Scene Snapshot (*.qtrs)"));
+    if (filePath.isEmpty()) return;
+    if (!WorldSnapshot::getInstance()->loadFromFile(*mWorld, filePath)) {
+        QMessageBox::critical(this, tr("Open Error"), tr("Failed to open scene:\n%1").arg(filePath));
+        return;
+    }
+
+    // 快照里带着导入模型的顶点，重新注册到 ResourceManager；材质和纹理由 BasePass 按需加载
+    mWorld->each<MeshComponent>([this](EntityID, MeshComponent &mesh) {
+        if (mResourceManager->getMeshGpuData(mesh.meshResourceId)) return;
+        if (mesh.geometry.isValid()) {
+            const GeometryArena *arena = GeometryArena::getInstance();
+            mResourceManager->loadMeshFromData(mesh.meshResourceId, arena->vertices(mesh.geometry),
+                                               arena->indices(mesh.geometry));
+        } else if (mesh.meshResourceId == MeshComponent::builtinCube()) {
+            mResourceManager->loadMeshFromData(BUILTIN_CUBE_MESH_ID, DEFAULT_CUBE_VERTICES, DEFAULT_CUBE_INDICES);
+        }
+    });
+
+    if (ObjectTransformEditor) ObjectTransformEditor->setCurrentObject(INVALID_ENTITY);
+    if (ObjectTextureEditor) ObjectTextureEditor->setCurrentObject(INVALID_ENTITY);
+}
+
 void EditorMainWindow::updateTransformFromEditor(EntityID entityId, const TransformUpdateData &data) {
     if (!mWorld) {
         qWarning("EditorMainWindow::updateTransformFromEditor - World is null.");
@@ -145,7 +181,7 @@ void EditorMainWindow::updateTransformFromEditor(EntityID entityId, const Transf
         return;
     }
 
-    TransformComponent *transform = mWorld->getComponent<TransformComponent>(entityId);
+    TransformComponent *transform = mWorld->getMutableComponent<TransformComponent>(entityId);
 
     if (transform) {
         qInfo() << "EditorMainWindow: Updating transform for Entity" << entityId
@@ -173,7 +209,7 @@ void EditorMainWindow::onTextureChanged(EntityID entityId, TextureType type, con
         return;
     }
 
-    MaterialComponent *matComp = mWorld->getComponent<MaterialComponent>(entityId);
+    MaterialComponent *matComp = mWorld->getMutableComponent<MaterialComponent>(entityId);
     if (!matComp) {
         qWarning() << "EditorMainWindow::onTextureChanged - Entity" << entityId << "does not have a MaterialComponent.";
         if (ObjectTextureEditor) ObjectTextureEditor->updateUI();
@@ -251,31 +287,20 @@ void EditorMainWindow::onCreateCube() {
         mResourceManager->loadMeshFromData(BUILTIN_CUBE_MESH_ID, DEFAULT_CUBE_VERTICES, DEFAULT_CUBE_INDICES);
     }
 
-    EntityID entity = mWorld->createEntity();
-    mWorld->addComponent<TransformComponent>(entity, {});
-    mWorld->addComponent<MeshComponent>(entity, {});
-    mWorld->addComponent<RenderableComponent>(entity, {});
-    mWorld->addComponent<MaterialComponent>(entity, {{}});
-
-    MaterialComponent *matComp = mWorld->getComponent<MaterialComponent>(entity);
-    matComp->albedoMapResourceId = DEFAULT_WHITE_TEXTURE_ID;
-    matComp->normalMapResourceId = DEFAULT_NORMAL_MAP_ID;
-    matComp->metallicRoughnessMapResourceId = DEFAULT_METALROUGH_TEXTURE_ID;
-    matComp->ambientOcclusionMapResourceId = DEFAULT_WHITE_TEXTURE_ID;
-    matComp->emissiveMapResourceId = DEFAULT_BLACK_TEXTURE_ID;
-
-    matComp->metallicFactor = 0.1f;
-    matComp->roughnessFactor = 0.8f;
-    matComp->albedoFactor = {1.0f, 1.0f, 1.0f};
-    matComp->aoStrength = 1.0f;
-    matComp->emissiveFactor = {0.0f, 0.0f, 0.0f};
-
-    MaterialComponent *mat = mWorld->getComponent<MaterialComponent>(entity);
-    mat->albedoMapResourceId = ":/img/Images/container2.png";
+    MaterialComponent matComp{{}};
+    matComp.albedoMapResourceId = ":/img/Images/container2.png";
+    matComp.normalMapResourceId = DEFAULT_NORMAL_MAP_ID;
+    matComp.metallicRoughnessMapResourceId = DEFAULT_METALROUGH_TEXTURE_ID;
+    matComp.ambientOcclusionMapResourceId = DEFAULT_WHITE_TEXTURE_ID;
+    matComp.emissiveMapResourceId = DEFAULT_BLACK_TEXTURE_ID;
 
-    if (SceneTree) {
-        SceneTree->refreshSceneTree();
-    }
+    matComp.metallicFactor = 0.1f;
+    matComp.roughnessFactor = 0.8f;
+    matComp.albedoFactor = {1.0f, 1.0f, 1.0f};
+    matComp.aoStrength = 1.0f;
+    matComp.emissiveFactor = {0.0f, 0.0f, 0.0f};
+
+    mWorld->createEntity(TransformComponent{}, MeshComponent{}, RenderableComponent{}, matComp);
 }
 
 void EditorMainWindow::onCreateSphere() {
@@ -291,10 +316,6 @@ void EditorMainWindow::onCreatePointLight() {
                                              {}, {}, {}, {}
                                          });
     // mWorld->addComponent<NameComponent>(entity, {"Point Light"});
-
-    if (SceneTree) {
-        SceneTree->refreshSceneTree();
-    }
     qInfo() << "Created Point Light Entity:" << entity;
 }
 
@@ -310,10 +331,12 @@ void EditorMainWindow::onCreateDirectionalLight() {
                                              {0.2f, 0.2f, 0.2f}, {0.5f, 0.5f, 0.5f},
                                              {1.0f, 1.0f, 1.0f}
                                          });
-    // mWorld->addComponent<NameComponent>(entity, {"Directional Light"});
-    if (SceneTree) {
-        SceneTree->refreshSceneTree();
+    // 场景中还没有有效的主方向光时，新建的方向光成为主光源
+    const auto *mainLight = mWorld->singleton<MainDirectionalLightSingleton>();
+    if (!mainLight || !mWorld->isAlive(mainLight->light)) {
+        mWorld->setSingleton(MainDirectionalLightSingleton{{}, entity});
     }
+    // mWorld->addComponent<NameComponent>(entity, {"Directional Light"});
     qInfo() << "Created Directional Light Entity:" << entity;
 }
 
@@ -395,6 +418,9 @@ void EditorMainWindow::InitEdgeLayout() {
     ObjectImportAction = ToolObjectMenu->addAction("导入模型");
     CreateCubeAction = ToolObjectMenu->addAction("立方体");
     CreateSphereAction = ToolObjectMenu->addAction("球体");
+    ToolObjectMenu->addSeparator();
+    SaveSceneAction = ToolObjectMenu->addAction("保存场景");
+    OpenSceneAction = ToolObjectMenu->addAction("打开场景");
     ToolObjectBtn->setMenu(ToolObjectMenu);
     toolBar->addWidget(ToolObjectBtn);
 
@@ -11,16 +11,21 @@
 #include "Component/MeshComponent.h"
 #include "Component/TransformComponent.h"
 #include "Component/RenderableComponent.h"
+#include "Component/SingletonComponents.h"
+#include "Component/TagComponents.h"
 #include "RenderGraph/BasePass.h"
 #include "RenderGraph/PresentPass.h"
 #include "RenderGraph/RenderGraph.h"
 #include "RenderGraph/RGBuilder.h"
 #include "Resources/ResourceManager.h"
 #include "Scene/Camera.h"
+#include "Scene/RenderScene.h"
 #include "System/InputSystem.h"
 #include "Scene/SystemManager.h"
 #include "Scene/World.h"
 #include "System/CameraSystem.h"
+#include "System/SpatialIndexSystem.h"
+#include "System/TransformSystem.h"
 
 ViewWindow::ViewWindow(RhiHelper::InitParams inInitParmas)
     : RHIWindow(inInitParmas) {
@@ -37,8 +42,13 @@ void ViewWindow::onInit() {
 
     mResourceManager->initialize(mRhi);
     mSystemManager->addSystem<CameraSystem>();
+    // 在相机和其他写 Transform 的系统之后传播层级变换，RenderGraph 读取的是本帧的世界矩阵
+    mSystemManager->addSystem<TransformSystem>();
+    // 按本帧的世界矩阵更新空间索引，供按距离查询灯光、相机附近的实体等
+    mSystemManager->addSystem<SpatialIndexSystem>();
 
     initializeScene();
+    mRenderScene = QSharedPointer<RenderScene>::create(mWorld);
 
     qInfo("ViewWindow::onInit - Creating RenderGraph...");
     if (!mSwapChainPassDesc) {
@@ -52,6 +62,7 @@ void ViewWindow::onInit() {
         mSwapChain->currentPixelSize(),
         mSwapChainPassDesc.get()
     );
+    mRenderGraph->setRenderScene(mRenderScene);
 
     defineRenderGraph(mRenderGraph.get());
 
@@ -66,6 +77,7 @@ void ViewWindow::onInit() {
 void ViewWindow::onExit() {
     qInfo("ViewWindow::onExit - Releasing RHI resources...");
     mRenderGraph.reset();
+    mRenderScene.reset();
     mResourceManager->releaseRhiResources();
 }
 
@@ -76,11 +88,14 @@ void ViewWindow::initializeScene() {
     mWorld->addComponent<TransformComponent>(cameraEntity, {});
     // 初始化屏幕比例
     float aspectRatio = mSwapChain->currentPixelSize().width() / (float) mSwapChain->currentPixelSize().height();
-    TransformComponent *camTransform = mWorld->getComponent<TransformComponent>(cameraEntity);
+    TransformComponent *camTransform = mWorld->getMutableComponent<TransformComponent>(cameraEntity);
     camTransform->setPosition(QVector3D(0, 0, 5));
     camTransform->rotate(180, QVector3D(0, 1, 0));
     mWorld->addComponent<CameraComponent>(cameraEntity, {{}, aspectRatio, 90.0f, 0.1f, 1000.0f});
     mWorld->addComponent<CameraControllerComponent>(cameraEntity, {});
+    mWorld->addComponent<ActiveCameraTag>(cameraEntity, {});
+    // BasePass 通过单例直接拿到渲染相机，不再遍历相机数组
+    mWorld->setSingleton(ActiveCameraSingleton{{}, cameraEntity});
     mCameraEntity = cameraEntity;
 
     mResourceManager->loadMeshFromData(BUILTIN_CUBE_MESH_ID, DEFAULT_CUBE_VERTICES, DEFAULT_CUBE_INDICES);
@@ -103,6 +118,14 @@ void ViewWindow::onRenderTick() {
     if (mSystemManager) {
         mSystemManager->updateAll(mWorld.get(), mCpuFrameTime);
     }
+    // 系统和编辑器在本帧写过的组件派发给 onChange 观察者
+    if (mWorld) {
+        mWorld->dispatchChangeObservers();
+    }
+    // 模拟到此结束，把本帧的变化发布给渲染端；目前两端都在 GUI 线程，RenderScene 允许把模拟移到单独的线程
+    if (mRenderScene) {
+        mRenderScene->publish();
+    }
 
     // --- 设置和执行渲染图 ---
     if (!mRhi || !mSwapChain || !mResourceManager || !mWorld) return;
@@ -116,6 +139,11 @@ void ViewWindow::onRenderTick() {
         return;
     }
 
+    if (mPendingOutputSize.isValid() && mResizeDebounce.elapsed() >= ResizeDebounceMs) {
+        updateRenderGraphResources(mPendingOutputSize);
+        mPendingOutputSize = QSize();
+    }
+
     if (!mRenderGraph->isCompiled()) {
         qWarning("ViewWindow::onRenderTick - RenderGraph is not compiled. Attempting recompile.");
         if (!mRenderGraph->getOutputSize().isValid() || mRenderGraph->getOutputSize().width() <= 0 || mRenderGraph->
@@ -145,7 +173,9 @@ void ViewWindow::onResize(const QSize &inSize) {
         qWarning("ViewWindow::onResize - RHI or RenderGraph not ready, or size is empty. Skipping resize logic.");
         return;
     }
-    updateRenderGraphResources(inSize);
+    // 只记下新尺寸，连续的缩放事件合并成一次重建
+    mPendingOutputSize = inSize;
+    mResizeDebounce.start();
 
     setCameraPerspective();
 }
@@ -153,8 +183,8 @@ void ViewWindow::onResize(const QSize &inSize) {
 void ViewWindow::setCameraPerspective() {
     QRhiRenderTarget *renderTarget = mSwapChain->currentFrameRenderTarget();
     if (mCameraEntity != INVALID_ENTITY) {
-        if (CameraComponent *camera = mWorld->getComponent<CameraComponent>(mCameraEntity)) {
-            mWorld->getComponent<CameraComponent>(mCameraEntity)->mAspect =
+        if (CameraComponent *camera = mWorld->getMutableComponent<CameraComponent>(mCameraEntity)) {
+            camera->mAspect =
                     renderTarget->pixelSize().width() / (float) renderTarget->pixelSize().height();
         }
     }
@@ -171,9 +201,9 @@ void ViewWindow::updateRenderGraphResources(const QSize &newSize) {
     qInfo() << "ViewWindow::updateRenderGraphResources - Updating RG for size" << newSize;
     mRenderGraph->setOutputSize(newSize); // Inform RG about the new size
 
-    qInfo() << "ViewWindow::updateRenderGraphResources - Recompiling RenderGraph...";
+    // 只重建相对尺寸的资源；图被其他改动作废时才会完整编译
     mRenderGraph->compile();
-    qInfo() << "ViewWindow::updateRenderGraphResources - RenderGraph recompiled.";
+    qInfo() << "ViewWindow::updateRenderGraphResources - RenderGraph updated.";
 }
 
 ViewRenderWidget::ViewRenderWidget(QWidget *parent) {
@@ -1,9 +1,10 @@
 #pragma once
+#include <QHash>
+#include <QSet>
 #include <QTreeWidget>
 
 #include "ECSCore.h"
-
-class World;
+#include "Scene/World.h"
 
 class SceneTreeWidget : public QTreeWidget {
     Q_OBJECT
@@ -11,17 +12,36 @@ class SceneTreeWidget : public QTreeWidget {
 public:
     explicit SceneTreeWidget(QWidget *parent = nullptr);
 
+    ~SceneTreeWidget() override;
+
+    // 注册 World 观察者，之后实体的增删和可见性变化会自动同步到场景树
     void setWorld(QSharedPointer<World> world);
 
 public slots:
+    // 丢弃现有条目并按 World 全量重建
     void refreshSceneTree();
 
 private slots:
     void handleSelectionChanged();
 
+    // 同步一轮事件循环内累积的实体变化
+    void flushPendingEntities();
+
 signals:
     void objectSelected(EntityID objId);
 
 private:
+    void detachWorld();
+
+    void scheduleEntityUpdate(EntityID entity);
+
+    // 按实体当前的组件新建、更新或删除它的条目
+    void syncEntityItem(EntityID entity);
+
     QSharedPointer<World> mWorld;
+    QVector<World::ObserverID> mObserverIds;
+
+    QHash<EntityID, QTreeWidgetItem *> mItemByEntity;
+    QSet<EntityID> mPendingEntities;
+    bool mFlushQueued = false;
 };
@@ -37,6 +37,10 @@ private slots:
 
     void onImportFailed(const QString &error);
 
+    void onSaveScene();
+
+    void onOpenScene();
+
     void updateTransformFromEditor(EntityID entityId, const TransformUpdateData &data);
 
     void onTextureChanged(EntityID entityId, TextureType type, const QString &newPath);
@@ -67,6 +71,8 @@ private:
     QAction *ObjectImportAction{nullptr};
     QAction *CreateCubeAction{nullptr};
     QAction *CreateSphereAction{nullptr};
+    QAction *SaveSceneAction{nullptr};
+    QAction *OpenSceneAction{nullptr};
 
     QToolButton *ToolLightBtn{nullptr};
     QMenu *ToolLightMenu{nullptr};
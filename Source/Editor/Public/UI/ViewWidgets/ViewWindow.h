@@ -1,10 +1,12 @@
 #pragma once
+#include <QElapsedTimer>
 #include <QWidget>
 
 #include "ECSCore.h"
 #include "UI/ViewWidgets/RHIWindow.h"
 
 class RenderGraph;
+class RenderScene;
 class SystemManager;
 class World;
 class ResourceManager;
@@ -55,9 +57,16 @@ private:
     QSharedPointer<SystemManager> mSystemManager;
 
     QSharedPointer<World> mWorld;
+    // 模拟端每帧发布的渲染快照，RenderGraph 只读取它
+    QSharedPointer<RenderScene> mRenderScene;
 
     QSharedPointer<RenderGraph> mRenderGraph;
 
+    // 拖动窗口时尺寸停止变化这么久之后才重建渲染图资源，期间按旧分辨率渲染，由 PresentPass 拉伸到交换链
+    static constexpr qint64 ResizeDebounceMs = 150;
+    QSize mPendingOutputSize;
+    QElapsedTimer mResizeDebounce;
+
     QPoint mLastMousePos;
 
     EntityID mCameraEntity;
@@ -23,6 +23,15 @@ layout (binding = 3, std140) uniform InstanceBuffer {
     InstanceUniformBlock instanceData[MAX_INSTANCES];
 } instanceBuffer;
 
+// CPU 端预先算好的法线矩阵（模型矩阵左上 3x3 的逆转置），按 mat4 存放只用左上 3x3
+struct InstanceNormalBlock {
+    mat4 normalMatrix;
+};
+
+layout (binding = 8, std140) uniform InstanceNormalBuffer {
+    InstanceNormalBlock instanceNormals[MAX_INSTANCES];
+} instanceNormalBuffer;
+
 // --- 输出到片元着色器 ---
 layout (location = 0) out vec3 fragPosWorld;    // 世界空间位置
 layout (location = 1) out vec2 fragTexCoord;    // 纹理坐标
@@ -38,8 +47,8 @@ void main() {
     viewPosWorld = cameraData.viewPos;
 
     // 计算 TBN 矩阵
-    // 法线矩阵 (用于变换法线和切线)
-    mat3 normalMatrix = mat3(transpose(inverse(currentModelMatrix)));
+    // 法线矩阵 (用于变换法线和切线)，由 CPU 在变换变化时计算，避免逐顶点求逆
+    mat3 normalMatrix = mat3(instanceNormalBuffer.instanceNormals[gl_InstanceIndex].normalMatrix);
 
     vec3 T = normalize(normalMatrix * inTangent);
     vec3 N = normalize(normalMatrix * inNormal);
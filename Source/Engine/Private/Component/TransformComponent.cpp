@@ -1,6 +1,6 @@
 #include "Component/TransformComponent.h"
 
-QMatrix4x4 TransformComponent::worldMatrix() const {
+QMatrix4x4 TransformComponent::localMatrix() const {
     QMatrix4x4 matrix;
     matrix.translate(mPosition);
     matrix.rotate(mRotation);
@@ -9,7 +9,7 @@ QMatrix4x4 TransformComponent::worldMatrix() const {
 }
 
 QMatrix3x3 TransformComponent::normalMatrix() const {
-    return worldMatrix().normalMatrix();
+    return localMatrix().normalMatrix();
 }
 
 void TransformComponent::translate(const QVector3D &translation) {
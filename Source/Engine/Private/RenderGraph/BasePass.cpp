@@ -1,15 +1,12 @@
 #include "RenderGraph/BasePass.h"
 
+#include <QScopeGuard>
+
 #include "CommonRender.h"
-#include "Component/CameraComponent.h"
-#include "Component/LightComponent.h"
-#include "Component/MeshComponent.h"
-#include "Component/RenderableComponent.h"
-#include "Component/TransformComponent.h"
-#include "Component/MaterialComponent.h"
 #include "RenderGraph/RGBuilder.h"
 #include "Resources/ResourceManager.h"
-#include "Scene/World.h"
+#include "Scene/JobSystem.h"
+#include "Scene/RenderScene.h"
 
 BasePass::BasePass(const QString &name): RGPass(name) {
 }
@@ -18,10 +15,10 @@ void BasePass::setup(RGBuilder &builder) {
     qInfo() << "BasePass::setup -" << name();
     mRhi = builder.rhi();
     mResourceManager = builder.resourceManager();
-    mWorld = builder.world();
+    mRenderScene = builder.renderScene();
 
-    if (!mRhi || !mResourceManager || !mWorld) {
-        qCritical("BasePass::setup - RHI, ResourceManager, or World is null!");
+    if (!mRhi || !mResourceManager || !mRenderScene) {
+        qCritical("BasePass::setup - RHI, ResourceManager, or RenderScene is null!");
         return;
     }
 
@@ -32,9 +29,9 @@ void BasePass::setup(RGBuilder &builder) {
     }
     qInfo() << "  Output size:" << outputSize;
 
-    // 声明输出资源
+    // 声明输出资源，尺寸跟随输出，窗口缩放时由 RenderGraph 直接重建
     mOutput.baseColor = builder.writeTexture("BaseColor",
-                                             outputSize,
+                                             RGSize::relative(),
                                              QRhiTexture::RGBA8,
                                              1,
                                              QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource);
@@ -43,7 +40,7 @@ void BasePass::setup(RGBuilder &builder) {
         return;
     }
     qInfo() << "  Declared Write: RGTexture 'BaseColor'";
-    mOutput.depthStencil = builder.writeDepthStencil("DepthStencil", outputSize, 1); // Name, Size, Sample Count
+    mOutput.depthStencil = builder.writeDepthStencil("DepthStencil", RGSize::relative(), 1); // Name, Size, Sample Count
     if (!mOutput.depthStencil.isValid()) {
         qCritical("BasePass::setup - Failed to declare DepthStencil buffer resource.");
         return;
@@ -86,7 +83,21 @@ void BasePass::setup(RGBuilder &builder) {
         return;
     }
     qInfo() << "  Declared Buffer: 'InstanceUBO' (Capacity:" << mMaxInstances << ")";
+
+    // 法线矩阵与模型矩阵同样的步长，绘制时两个 UBO 使用相同的偏移区间
+    static_assert(sizeof(InstanceNormalUniformBlock) == sizeof(InstanceUniformBlock));
+    mInstanceNormalUboRef = builder.createBuffer("InstanceNormalUBO", QRhiBuffer::Dynamic,
+                                                 QRhiBuffer::UniformBuffer,
+                                                 mMaxInstances * mInstanceBlockAlignedSize);
+    if (!mInstanceNormalUboRef.isValid()) {
+        qCritical("BasePass::setup - Failed to declare InstanceNormalUBO.");
+        return;
+    }
+    qInfo() << "  Declared Buffer: 'InstanceNormalUBO'";
     mInstanceDataBuffer.resize(mMaxInstances);
+    mInstanceNormalBuffer.resize(mMaxInstances);
+    // 实例 UBO 是新建的，缓存的批次需要重新收集并完整上传
+    mDrawBucketsValid = false;
 
     // --- 设置 Sampler ---
     mDefaultSamplerRef = builder.setupSampler("DefaultSampler",
@@ -154,7 +165,10 @@ void BasePass::setup(RGBuilder &builder) {
         // Binding 6: Ambient Occlusion Map + Sampler
         QRhiShaderResourceBinding::sampledTexture(6, QRhiShaderResourceBinding::FragmentStage, nullptr, nullptr),
         // Binding 7: Emissive Map + Sampler
-        QRhiShaderResourceBinding::sampledTexture(7, QRhiShaderResourceBinding::FragmentStage, nullptr, nullptr)
+        QRhiShaderResourceBinding::sampledTexture(7, QRhiShaderResourceBinding::FragmentStage, nullptr, nullptr),
+        // Binding 8: Instance Normal Matrix UBO (VS) - Dynamic Offset
+        QRhiShaderResourceBinding::uniformBuffer(8, QRhiShaderResourceBinding::VertexStage, nullptr, 0,
+                                                 mInstanceBlockAlignedSize)
     };
 
     mBaseSrbLayoutRef = builder.setupShaderResourceBindings("PbrPipelineSRBLayout", bindingsLayout);
@@ -189,20 +203,22 @@ void BasePass::execute(QRhiCommandBuffer *cmdBuffer) {
     QRhiBuffer *cameraUbo = mCameraUboRef.get();
     QRhiBuffer *lightingUbo = mLightingUboRef.get();
     QRhiBuffer *instanceUbo = mInstanceUboRef.get();
+    QRhiBuffer *instanceNormalUbo = mInstanceNormalUboRef.get();
     QRhiSampler *defaultSampler = mDefaultSamplerRef.get();
 
-    if (!pipeline || !renderTarget || !cameraUbo || !lightingUbo || !instanceUbo || !defaultSampler || !
-        mWorld || !mResourceManager || !mRhi) {
+    if (!pipeline || !renderTarget || !cameraUbo || !lightingUbo || !instanceUbo || !instanceNormalUbo ||
+        !defaultSampler || !mRenderScene || !mResourceManager || !mRhi) {
         qWarning(
-            "BasePass::execute [%s] - Prerequisites not met (RHI objects, managers, or world missing/invalid). Skipping.",
+            "BasePass::execute [%s] - Prerequisites not met (RHI objects, managers, or render scene missing/invalid). Skipping.",
             qPrintable(name()));
         qWarning() << "  Pipeline:" << pipeline << "(Ref valid:" << mPipelineRef.isValid() << ")";
         qWarning() << "  RT:" << renderTarget << "(Ref valid:" << mRenderTargetRef.isValid() << ")";
         qWarning() << "  CamUBO:" << cameraUbo << "(Ref valid:" << mCameraUboRef.isValid() << ")";
         qWarning() << "  LightUBO:" << lightingUbo << "(Ref valid:" << mLightingUboRef.isValid() << ")";
         qWarning() << "  InstUBO:" << instanceUbo << "(Ref valid:" << mInstanceUboRef.isValid() << ")";
+        qWarning() << "  InstNormalUBO:" << instanceNormalUbo << "(Ref valid:" << mInstanceNormalUboRef.isValid() << ")";
         qWarning() << "  Sampler:" << defaultSampler << "(Ref valid:" << mDefaultSamplerRef.isValid() << ")";
-        qWarning() << "  World:" << mWorld.data() << " ResMgr:" << mResourceManager.data() << " RHI:" << mRhi;
+        qWarning() << "  RenderScene:" << mRenderScene.data() << " ResMgr:" << mResourceManager.data() << " RHI:" << mRhi;
         return;
     }
 
@@ -236,119 +252,55 @@ void BasePass::execute(QRhiCommandBuffer *cmdBuffer) {
         qWarning("BasePass::execute [%s] - Failed to get resource update batch.", qPrintable(name()));
         return;
     }
-    updateUniforms(resourceBatch);
-
-    int currentInstanceIndex = 0;
-    QHash<QString, QHash<QString, QVector<EntityID> > > entitiesByMeshThenMaterial;
-    for (EntityID entity: mWorld->view<RenderableComponent, MeshComponent, MaterialComponent, TransformComponent>()) {
-        const auto *renderable = mWorld->getComponent<RenderableComponent>(entity);
-        const auto *meshComp = mWorld->getComponent<MeshComponent>(entity);
-        const auto *matComp = mWorld->getComponent<MaterialComponent>(entity);
-        const auto *tfComp = mWorld->getComponent<TransformComponent>(entity);
-
-        if (renderable && renderable->isVisible && meshComp && !meshComp->meshResourceId.isEmpty()
-            && matComp && tfComp) {
-            if (currentInstanceIndex >= mMaxInstances) {
-                qWarning("BasePass::execute [%s] - Exceeded max instances (%d). Some objects may not be drawn.",
-                         qPrintable(name()), mMaxInstances);
-                break;
-            }
-
-            QString meshId = meshComp->meshResourceId;
-            QString materialCacheKey = mResourceManager->generateMaterialCacheKey(matComp);
-
-            RhiMaterialGpuData *matGpu = mResourceManager->getMaterialGpuData(materialCacheKey);
-            if (!matGpu) {
-                mResourceManager->loadMaterial(materialCacheKey, matComp);
-                matGpu = mResourceManager->getMaterialGpuData(materialCacheKey);
-                if (!matGpu) {
-                    qWarning("BasePass::execute [%s] - Failed to load material '%s' for entity %lld.",
-                             qPrintable(name()), qPrintable(materialCacheKey), entity);
-                    continue; // Skip this entity
-                }
-                qInfo() << "Loaded new material:" << materialCacheKey;
-            }
-            if (!matGpu->ready) {
-                mResourceManager->queueMaterialUpdate(materialCacheKey, resourceBatch);
-            }
-            RhiTextureGpuData *albedoTexGpu = nullptr;
-            if (matGpu && !matGpu->albedoId.isEmpty()) {
-                albedoTexGpu = mResourceManager->getTextureGpuData(matGpu->albedoId);
-            }
-            if (!albedoTexGpu || !albedoTexGpu->ready) {
-                QString texId = matGpu ? matGpu->albedoId : "(unknown)";
-                if (matGpu && !matGpu->albedoId.isEmpty()) {
-                    qInfo(
-                        "BasePass::execute [%s] - Albedo texture '%s' for material '%s' not ready/found, queuing load/update.",
-                        qPrintable(name()), qPrintable(texId), qPrintable(materialCacheKey));
-                    mResourceManager->queueTextureUpdate(texId, resourceBatch);
-                } else {
-                    matGpu->albedoId = DEFAULT_WHITE_TEXTURE_ID;
-                    albedoTexGpu = mResourceManager->getTextureGpuData(DEFAULT_WHITE_TEXTURE_ID);
-                    if (!albedoTexGpu || !albedoTexGpu->ready) {
-                        mResourceManager->queueTextureUpdate(DEFAULT_WHITE_TEXTURE_ID, resourceBatch);
-                        qWarning("BasePass::execute [%s] - Fallback white texture not ready, queuing update.",
-                                 qPrintable(name()));
-                    }
-                }
-            }
-
-            RhiMeshGpuData *meshGpu = mResourceManager->getMeshGpuData(meshId);
-            if (!meshGpu) {
-                qWarning(
-                    "BasePass::execute [%s] - Mesh GPU data for ID '%s' not found (entity %lld). Did you call loadMeshFromData?",
-                    qPrintable(name()), qPrintable(meshId), entity);
-                continue;
-            }
-            if (!meshGpu->ready) {
-                qInfo() << "BasePass::execute [" << name() << "] - Mesh '" << meshId <<
-                        "' not ready, queuing update...";
-                bool queued = mResourceManager->queueMeshUpdate(meshId, resourceBatch);
-                if (!queued) {
-                    qWarning("BasePass::execute [%s] - Failed to queue mesh update for '%s'.", qPrintable(name()),
-                             qPrintable(meshId));
-                    continue;
-                }
-                meshGpu = mResourceManager->getMeshGpuData(meshId);
-                if (!meshGpu || !meshGpu->ready) {
-                    qWarning(
-                        "BasePass::execute [%s] - Mesh '%s' still not ready after queueing update. Skipping entity %lld.",
-                        qPrintable(name()), qPrintable(meshId), entity);
-                    continue;
-                }
-                qInfo() << "BasePass::execute [" << name() << "] - Mesh '" << meshId <<
-                        "' successfully queued and marked ready.";
+    // --- 场景数据 ---
+    // 只在读取快照期间持有前台帧，录制绘制命令时模拟端已经可以发布下一帧
+    bool instanceDataDirty = false;
+    {
+        RenderSceneChanges changes;
+        const RenderSceneFrame &frame = mRenderScene->acquireFrame(changes);
+        const auto frameGuard = qScopeGuard([this] { mRenderScene->releaseFrame(); });
+
+        updateUniforms(resourceBatch, frame);
+
+        // 只有快照报告的实体重新归桶；没有桶发生变化时复用上一帧的批次，只回写移动过的实例矩阵
+        bool needsLayout = false;
+        if (!mDrawBucketsValid || changes.reset) {
+            resetDrawBuckets(frame);
+            mDrawBucketsValid = true;
+            needsLayout = true;
+        } else {
+            for (EntityID entity: std::as_const(changes.drawChanged)) {
+                mPendingEntities.insert(entity);
             }
-            if (meshGpu && meshGpu->ready && matGpu && matGpu->ready && albedoTexGpu && albedoTexGpu->ready &&
-                meshGpu->vertexBuffer && meshGpu->indexBuffer) {
-                entitiesByMeshThenMaterial[meshId][materialCacheKey].append(entity);
-                if (tfComp) {
-                    mInstanceDataBuffer[currentInstanceIndex].model = tfComp->worldMatrix().toGenericMatrix<4, 4>();
-                } else {
-                    qWarning() << "BasePass::execute - Entity" << entity <<
-                            "missing TransformComponent when preparing instance data.";
-                    continue;
+        }
+        if (updateDrawBuckets(frame, resourceBatch)) {
+            needsLayout = true;
+        }
+        instanceDataDirty = needsLayout;
+        if (needsLayout) {
+            layoutDrawBatches(frame);
+        } else {
+            const QVector<EntityID> &changed = changes.transformChanged;
+            InstanceUniformBlock *instances = mInstanceDataBuffer.data();
+            InstanceNormalUniformBlock *normals = mInstanceNormalBuffer.data();
+            std::atomic<bool> anyInstanceChanged{false};
+            // 每个实例只写自己的槽位，可以按块并行
+            JobSystem::getInstance()->parallelFor(changed.size(), 512, [&](qint32 begin, qint32 end) {
+                for (qint32 i = begin; i < end; ++i) {
+                    const qint32 instanceIndex = std::as_const(mInstanceIndexByEntity).value(changed[i], -1);
+                    const RenderInstanceProxy *proxy = frame.findInstance(changed[i]);
+                    if (instanceIndex < 0 || !proxy) continue;
+                    instances[instanceIndex] = proxy->instance;
+                    normals[instanceIndex] = proxy->normal;
+                    anyInstanceChanged.store(true, std::memory_order_relaxed);
                 }
-                currentInstanceIndex++;
-            } else {
-                if (!meshGpu->ready)
-                    qWarning() << "Skipping entity" << entity << "because mesh" << meshId << "not ready.";
-                else if (!matGpu || !matGpu->ready)
-                    qWarning() << "Skipping entity" << entity << "because material" << materialCacheKey << "not ready.";
-                else if (!albedoTexGpu || !albedoTexGpu->ready)
-                    qWarning() << "Skipping entity" << entity << "because albedo texture" << (
-                        matGpu ? matGpu->albedoId : "N/A") << "not ready.";
-                else if (!meshGpu->vertexBuffer)
-                    qWarning() << "Skipping entity" << entity << "because mesh" << meshId << "vertex buffer is null.";
-                else if (!meshGpu->indexBuffer)
-                    qWarning() << "Skipping entity" << entity << "because mesh" << meshId << "index buffer is null.";
-            }
-        } else if (meshComp && meshComp->meshResourceId.isEmpty()) {
-            qWarning("Entity %lld has MeshComponent but no meshResourceId set.", entity);
+            });
+            instanceDataDirty = anyInstanceChanged.load(std::memory_order_relaxed);
         }
     }
-
-    uploadInstanceData(resourceBatch, currentInstanceIndex);
+    if (instanceDataDirty) {
+        uploadInstanceData(resourceBatch, mInstanceCount);
+    }
 
     cmdBuffer->resourceUpdate(resourceBatch);
 
@@ -364,152 +316,342 @@ void BasePass::execute(QRhiCommandBuffer *cmdBuffer) {
     cmdBuffer->setScissor({0, 0, outputSize.width(), outputSize.height()});
 
     // --- 绘制实体 ---
-    int totalInstancesDrawnThisPass = 0;
-    for (auto meshIt = entitiesByMeshThenMaterial.constBegin();
-         meshIt != entitiesByMeshThenMaterial.constEnd(); ++meshIt) {
-        const QString &meshId = meshIt.key();
-        const QHash<QString, QVector<EntityID> > &materials = meshIt.value();
+    QString boundMeshId;
+    for (const DrawBatch &drawBatch: std::as_const(mDrawBatches)) {
+        const QString &meshId = drawBatch.meshId;
+        const QString &materialId = drawBatch.materialId;
+        if (drawBatch.instanceCount == 0) {
+            continue;
+        }
+
         RhiMeshGpuData *meshGpu = mResourceManager->getMeshGpuData(meshId);
         if (!meshGpu || !meshGpu->ready || !meshGpu->vertexBuffer || !meshGpu->indexBuffer || meshGpu->indexCount ==
             0) {
             qWarning("BasePass::execute [%s] - Skipping draw for mesh '%s': Mesh GPU data invalid or not ready.",
                      qPrintable(name()), qPrintable(meshId));
-            for (const auto &matEntities: materials)
-                totalInstancesDrawnThisPass += matEntities.size();
             continue;
         }
 
-        // 设置顶点和索引Buffer
-        QRhiCommandBuffer::VertexInput vtxBinding(meshGpu->vertexBuffer.get(), 0);
-        cmdBuffer->setVertexInput(0, 1, &vtxBinding, meshGpu->indexBuffer.get(), 0, QRhiCommandBuffer::IndexUInt16);
-
-        for (auto matIt = materials.constBegin(); matIt != materials.constEnd(); ++matIt) {
-            const QString &materialId = matIt.key();
-            const QVector<EntityID> &entitiesInBatch = matIt.value();
+        // 批次按 mesh 连续排列，同一 mesh 只设置一次顶点和索引Buffer
+        if (meshId != boundMeshId) {
+            QRhiCommandBuffer::VertexInput vtxBinding(meshGpu->vertexBuffer.get(), 0);
+            cmdBuffer->setVertexInput(0, 1, &vtxBinding, meshGpu->indexBuffer.get(), 0,
+                                      QRhiCommandBuffer::IndexUInt16);
+            boundMeshId = meshId;
+        }
 
-            if (entitiesInBatch.isEmpty()) {
-                continue;
-            }
+        RhiMaterialGpuData *matGpu = mResourceManager->getMaterialGpuData(materialId);
+        const quint32 currentBatchInstanceCount = drawBatch.instanceCount;
 
-            RhiMaterialGpuData *matGpu = mResourceManager->getMaterialGpuData(materialId);
-            const quint32 currentBatchInstanceCount = entitiesInBatch.size();
+        if (!matGpu || !matGpu->ready) {
+            qWarning(
+                "BasePass::execute [%s] - Skipping draw for material '%s': Material GPU data invalid or not ready.",
+                qPrintable(name()), qPrintable(materialId));
+            continue;
+        }
 
-            if (!matGpu || !matGpu->ready) {
-                qWarning(
-                    "BasePass::execute [%s] - Skipping draw for material '%s': Material GPU data invalid or not ready.",
-                    qPrintable(name()), qPrintable(materialId));
-                totalInstancesDrawnThisPass += currentBatchInstanceCount; // Advance count even if skipping
-                continue;
+        auto getTexOrDefault = [&](const QString &id, const QString &defaultId) -> RhiTextureGpuData * {
+            RhiTextureGpuData *texData = mResourceManager->getTextureGpuData(id);
+            if (texData && texData->ready && texData->texture) {
+                return texData;
             }
-
-            auto getTexOrDefault = [&](const QString &id, const QString &defaultId) -> RhiTextureGpuData * {
-                RhiTextureGpuData *texData = mResourceManager->getTextureGpuData(id);
-                if (texData && texData->ready && texData->texture) {
-                    return texData;
-                }
-                qDebug() << "BasePass: Texture" << id << "not ready or found, using default" << defaultId;
-                RhiTextureGpuData *defaultTexData = mResourceManager->getTextureGpuData(defaultId);
-                if (!defaultTexData || !defaultTexData->ready || !defaultTexData->texture) {
-                    qWarning() << "BasePass: Default texture" << defaultId << "is also not ready!";
-                    if (defaultId != DEFAULT_WHITE_TEXTURE_ID) {
-                        defaultTexData = mResourceManager->getTextureGpuData(DEFAULT_WHITE_TEXTURE_ID);
-                        if (!defaultTexData || !defaultTexData->ready || !defaultTexData->texture) {
-                            qCritical("BasePass: CRITICAL - Default white texture not ready!");
-                            return nullptr;
-                        }
-                    } else {
+            qDebug() << "BasePass: Texture" << id << "not ready or found, using default" << defaultId;
+            RhiTextureGpuData *defaultTexData = mResourceManager->getTextureGpuData(defaultId);
+            if (!defaultTexData || !defaultTexData->ready || !defaultTexData->texture) {
+                qWarning() << "BasePass: Default texture" << defaultId << "is also not ready!";
+                if (defaultId != DEFAULT_WHITE_TEXTURE_ID) {
+                    defaultTexData = mResourceManager->getTextureGpuData(DEFAULT_WHITE_TEXTURE_ID);
+                    if (!defaultTexData || !defaultTexData->ready || !defaultTexData->texture) {
                         qCritical("BasePass: CRITICAL - Default white texture not ready!");
                         return nullptr;
                     }
+                } else {
+                    qCritical("BasePass: CRITICAL - Default white texture not ready!");
+                    return nullptr;
                 }
-                return defaultTexData;
-            };
-
-            RhiTextureGpuData *albedoTexGpu = getTexOrDefault(matGpu->albedoId, DEFAULT_WHITE_TEXTURE_ID);
-            RhiTextureGpuData *normalTexGpu = getTexOrDefault(matGpu->normalId, DEFAULT_NORMAL_MAP_ID);
-            RhiTextureGpuData *metalRoughTexGpu = getTexOrDefault(matGpu->metallicRoughnessId,
-                                                                  DEFAULT_METALROUGH_TEXTURE_ID);
-            RhiTextureGpuData *aoTexGpu = getTexOrDefault(matGpu->aoId, DEFAULT_WHITE_TEXTURE_ID);
-            RhiTextureGpuData *emissiveTexGpu = getTexOrDefault(matGpu->emissiveId, DEFAULT_BLACK_TEXTURE_ID);
-
-            if (!albedoTexGpu) {
-                qWarning(
-                    "BasePass::execute [%s] - Could not get even default Albedo texture for material '%s'. Skipping draw.",
-                    qPrintable(name()), qPrintable(materialId));
-                totalInstancesDrawnThisPass += currentBatchInstanceCount;
-                continue;
-            }
-            if (!normalTexGpu || !metalRoughTexGpu || !aoTexGpu || !emissiveTexGpu) {
-                qWarning(
-                    "BasePass::execute [%s] - Failed to get one or more default textures for material '%s'. Draw might be incorrect.",
-                    qPrintable(name()), qPrintable(materialId));
             }
+            return defaultTexData;
+        };
+
+        RhiTextureGpuData *albedoTexGpu = getTexOrDefault(matGpu->albedoId, DEFAULT_WHITE_TEXTURE_ID);
+        RhiTextureGpuData *normalTexGpu = getTexOrDefault(matGpu->normalId, DEFAULT_NORMAL_MAP_ID);
+        RhiTextureGpuData *metalRoughTexGpu = getTexOrDefault(matGpu->metallicRoughnessId,
+                                                              DEFAULT_METALROUGH_TEXTURE_ID);
+        RhiTextureGpuData *aoTexGpu = getTexOrDefault(matGpu->aoId, DEFAULT_WHITE_TEXTURE_ID);
+        RhiTextureGpuData *emissiveTexGpu = getTexOrDefault(matGpu->emissiveId, DEFAULT_BLACK_TEXTURE_ID);
+
+        if (!albedoTexGpu) {
+            qWarning(
+                "BasePass::execute [%s] - Could not get even default Albedo texture for material '%s'. Skipping draw.",
+                qPrintable(name()), qPrintable(materialId));
+            continue;
+        }
+        if (!normalTexGpu || !metalRoughTexGpu || !aoTexGpu || !emissiveTexGpu) {
+            qWarning(
+                "BasePass::execute [%s] - Failed to get one or more default textures for material '%s'. Draw might be incorrect.",
+                qPrintable(name()), qPrintable(materialId));
+        }
+
+        QScopedPointer<QRhiShaderResourceBindings> drawSrb(mRhi->newShaderResourceBindings());
+        if (!drawSrb) {
+            qWarning("BasePass::execute [%s] - Failed to create new QRhiShaderResourceBindings.",
+                     qPrintable(name()));
+            continue;
+        }
+        drawSrb->setBindings({
+            // Binding 0: Camera UBO
+            QRhiShaderResourceBinding::uniformBuffer(
+                0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage, cameraUbo),
+            // Binding 1: Lighting UBO
+            QRhiShaderResourceBinding::uniformBuffer(1, QRhiShaderResourceBinding::FragmentStage, lightingUbo),
+            // Binding 2: Albedo Map
+            QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage,
+                                                      albedoTexGpu->texture.get(), defaultSampler),
+            // Binding 3: Instance UBO (Dynamic Offset)
+            QRhiShaderResourceBinding::uniformBuffer(3, QRhiShaderResourceBinding::VertexStage, instanceUbo,
+                                                     drawBatch.firstInstance * mInstanceBlockAlignedSize,
+                                                     currentBatchInstanceCount * mInstanceBlockAlignedSize),
+            // Binding 4: Normal Map
+            QRhiShaderResourceBinding::sampledTexture(4, QRhiShaderResourceBinding::FragmentStage,
+                                                      normalTexGpu->texture.get(), defaultSampler),
+            // Binding 5: Metallic/Roughness Map
+            QRhiShaderResourceBinding::sampledTexture(5, QRhiShaderResourceBinding::FragmentStage,
+                                                      metalRoughTexGpu->texture.get(), defaultSampler),
+            // Binding 6: AO Map
+            QRhiShaderResourceBinding::sampledTexture(6, QRhiShaderResourceBinding::FragmentStage,
+                                                      aoTexGpu->texture.get(), defaultSampler),
+            // Binding 7: Emissive Map
+            QRhiShaderResourceBinding::sampledTexture(7, QRhiShaderResourceBinding::FragmentStage,
+                                                      emissiveTexGpu->texture.get(), defaultSampler),
+            // Binding 8: Instance Normal Matrix UBO (Dynamic Offset)
+            QRhiShaderResourceBinding::uniformBuffer(8, QRhiShaderResourceBinding::VertexStage, instanceNormalUbo,
+                                                     drawBatch.firstInstance * mInstanceBlockAlignedSize,
+                                                     currentBatchInstanceCount * mInstanceBlockAlignedSize)
+        });
+        if (!drawSrb->create()) {
+            qWarning("BasePass::execute [%s] - Failed to create draw SRB for mesh '%s', material '%s'.",
+                     qPrintable(name()), qPrintable(meshId), qPrintable(materialId));
+            continue;
+        }
 
-            QScopedPointer<QRhiShaderResourceBindings> drawSrb(mRhi->newShaderResourceBindings());
-            if (!drawSrb) {
-                qWarning("BasePass::execute [%s] - Failed to create new QRhiShaderResourceBindings.",
+        cmdBuffer->setShaderResources(drawSrb.get());
+
+        // 绘制实例
+        cmdBuffer->drawIndexed(meshGpu->indexCount, currentBatchInstanceCount);
+    }
+    // End Render Pass
+    cmdBuffer->endPass();
+}
+
+void BasePass::resetDrawBuckets(const RenderSceneFrame &frame) {
+    mEntitiesByMeshThenMaterial.clear();
+    mDrawSlotByEntity.clear();
+    mPendingEntities.clear();
+    for (const RenderInstanceProxy &proxy: frame.instances) {
+        mPendingEntities.insert(proxy.entity);
+    }
+}
+
+bool BasePass::updateDrawBuckets(const RenderSceneFrame &frame, QRhiResourceUpdateBatch *resourceBatch) {
+    if (mPendingEntities.isEmpty()) return false;
+
+    bool changed = false;
+    QSet<EntityID> stillPending;
+    for (EntityID entity: std::as_const(mPendingEntities)) {
+        QString meshId;
+        QString materialId;
+        // 快照中已经没有的实体（被删除、隐藏或缺少组件）从桶中移除
+        const RenderInstanceProxy *proxy = frame.findInstance(entity);
+        const DrawKeyStatus status = proxy
+                                         ? resolveDrawKey(*proxy, resourceBatch, meshId, materialId)
+                                         : DrawKeyStatus::NotDrawable;
+        if (status == DrawKeyStatus::Pending) {
+            stillPending.insert(entity);
+        }
+
+        const auto slot = mDrawSlotByEntity.constFind(entity);
+        const bool wasDrawn = slot != mDrawSlotByEntity.constEnd();
+        if (status == DrawKeyStatus::Ready && wasDrawn && slot->meshId == meshId && slot->materialId == materialId) {
+            continue;
+        }
+        if (wasDrawn) {
+            removeFromDrawBucket(entity);
+            changed = true;
+        }
+        if (status == DrawKeyStatus::Ready) {
+            addToDrawBucket(entity, meshId, materialId);
+            changed = true;
+        }
+    }
+    mPendingEntities = std::move(stillPending);
+    return changed;
+}
+
+void BasePass::addToDrawBucket(EntityID entity, const QString &meshId, const QString &materialId) {
+    QVector<EntityID> &bucket = mEntitiesByMeshThenMaterial[meshId][materialId];
+    mDrawSlotByEntity.insert(entity, DrawSlot{meshId, materialId, static_cast<qint32>(bucket.size())});
+    bucket.append(entity);
+}
+
+void BasePass::removeFromDrawBucket(EntityID entity) {
+    const DrawSlot slot = mDrawSlotByEntity.take(entity);
+    auto meshIt = mEntitiesByMeshThenMaterial.find(slot.meshId);
+    if (meshIt == mEntitiesByMeshThenMaterial.end()) return;
+    auto matIt = meshIt->find(slot.materialId);
+    if (matIt == meshIt->end()) return;
+
+    // 与桶末尾交换删除，桶内顺序不影响绘制
+    QVector<EntityID> &bucket = *matIt;
+    const EntityID last = bucket.last();
+    bucket[slot.index] = last;
+    if (last != entity) {
+        mDrawSlotByEntity[last].index = slot.index;
+    }
+    bucket.removeLast();
+    if (bucket.isEmpty()) {
+        meshIt->erase(matIt);
+        if (meshIt->isEmpty()) {
+            mEntitiesByMeshThenMaterial.erase(meshIt);
+        }
+    }
+}
+
+BasePass::DrawKeyStatus BasePass::resolveDrawKey(const RenderInstanceProxy &proxy,
+                                                 QRhiResourceUpdateBatch *resourceBatch,
+                                                 QString &meshId, QString &materialId) {
+    // 快照只收录可见且组件齐全的实体，这里只需处理 GPU 资源
+    const EntityID entity = proxy.entity;
+    const MaterialComponent *matComp = &proxy.material;
+    meshId = proxy.meshId;
+    const QString materialCacheKey = mResourceManager->generateMaterialCacheKey(matComp);
+    materialId = materialCacheKey;
+
+    RhiMaterialGpuData *matGpu = mResourceManager->getMaterialGpuData(materialCacheKey);
+    if (!matGpu) {
+        mResourceManager->loadMaterial(materialCacheKey, matComp);
+        matGpu = mResourceManager->getMaterialGpuData(materialCacheKey);
+        if (!matGpu) {
+            qWarning("BasePass::resolveDrawKey [%s] - Failed to load material '%s' for entity %lld.",
+                     qPrintable(name()), qPrintable(materialCacheKey), entity);
+            return DrawKeyStatus::Pending;
+        }
+        qInfo() << "Loaded new material:" << materialCacheKey;
+    }
+    if (!matGpu->ready) {
+        mResourceManager->queueMaterialUpdate(materialCacheKey, resourceBatch);
+    }
+    RhiTextureGpuData *albedoTexGpu = nullptr;
+    if (matGpu && !matGpu->albedoId.isEmpty()) {
+        albedoTexGpu = mResourceManager->getTextureGpuData(matGpu->albedoId);
+    }
+    if (!albedoTexGpu || !albedoTexGpu->ready) {
+        QString texId = matGpu ? matGpu->albedoId : "(unknown)";
+        if (matGpu && !matGpu->albedoId.isEmpty()) {
+            qInfo(
+                "BasePass::resolveDrawKey [%s] - Albedo texture '%s' for material '%s' not ready/found, queuing load/update.",
+                qPrintable(name()), qPrintable(texId), qPrintable(materialCacheKey));
+            mResourceManager->queueTextureUpdate(texId, resourceBatch);
+        } else {
+            matGpu->albedoId = DEFAULT_WHITE_TEXTURE_ID;
+            albedoTexGpu = mResourceManager->getTextureGpuData(DEFAULT_WHITE_TEXTURE_ID);
+            if (!albedoTexGpu || !albedoTexGpu->ready) {
+                mResourceManager->queueTextureUpdate(DEFAULT_WHITE_TEXTURE_ID, resourceBatch);
+                qWarning("BasePass::resolveDrawKey [%s] - Fallback white texture not ready, queuing update.",
                          qPrintable(name()));
-                totalInstancesDrawnThisPass += currentBatchInstanceCount;
-                continue;
-            }
-            if (currentBatchInstanceCount == 0) continue;
-            drawSrb->setBindings({
-                // Binding 0: Camera UBO
-                QRhiShaderResourceBinding::uniformBuffer(
-                    0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage, cameraUbo),
-                // Binding 1: Lighting UBO
-                QRhiShaderResourceBinding::uniformBuffer(1, QRhiShaderResourceBinding::FragmentStage, lightingUbo),
-                // Binding 2: Albedo Map
-                QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage,
-                                                          albedoTexGpu->texture.get(), defaultSampler),
-                // Binding 3: Instance UBO (Dynamic Offset)
-                QRhiShaderResourceBinding::uniformBuffer(3, QRhiShaderResourceBinding::VertexStage, instanceUbo,
-                                                         totalInstancesDrawnThisPass * mInstanceBlockAlignedSize,
-                                                         currentBatchInstanceCount * mInstanceBlockAlignedSize),
-                // Binding 4: Normal Map
-                QRhiShaderResourceBinding::sampledTexture(4, QRhiShaderResourceBinding::FragmentStage,
-                                                          normalTexGpu->texture.get(), defaultSampler),
-                // Binding 5: Metallic/Roughness Map
-                QRhiShaderResourceBinding::sampledTexture(5, QRhiShaderResourceBinding::FragmentStage,
-                                                          metalRoughTexGpu->texture.get(), defaultSampler),
-                // Binding 6: AO Map
-                QRhiShaderResourceBinding::sampledTexture(6, QRhiShaderResourceBinding::FragmentStage,
-                                                          aoTexGpu->texture.get(), defaultSampler),
-                // Binding 7: Emissive Map
-                QRhiShaderResourceBinding::sampledTexture(7, QRhiShaderResourceBinding::FragmentStage,
-                                                          emissiveTexGpu->texture.get(), defaultSampler)
-            });
-            if (!drawSrb->create()) {
-                qWarning("BasePass::execute [%s] - Failed to create draw SRB for mesh '%s', material '%s'.",
-                         qPrintable(name()), qPrintable(meshId), qPrintable(materialId));
-                totalInstancesDrawnThisPass += currentBatchInstanceCount;
-                continue;
             }
+        }
+    }
 
-            cmdBuffer->setShaderResources(drawSrb.get());
+    RhiMeshGpuData *meshGpu = mResourceManager->getMeshGpuData(meshId);
+    if (!meshGpu) {
+        qWarning(
+            "BasePass::resolveDrawKey [%s] - Mesh GPU data for ID '%s' not found (entity %lld). Did you call loadMeshFromData?",
+            qPrintable(name()), qPrintable(meshId), entity);
+        return DrawKeyStatus::Pending;
+    }
+    if (!meshGpu->ready) {
+        qInfo() << "BasePass::resolveDrawKey [" << name() << "] - Mesh '" << meshId <<
+                "' not ready, queuing update...";
+        bool queued = mResourceManager->queueMeshUpdate(meshId, resourceBatch);
+        if (!queued) {
+            qWarning("BasePass::resolveDrawKey [%s] - Failed to queue mesh update for '%s'.", qPrintable(name()),
+                     qPrintable(meshId));
+            return DrawKeyStatus::Pending;
+        }
+        meshGpu = mResourceManager->getMeshGpuData(meshId);
+        if (!meshGpu || !meshGpu->ready) {
+            qWarning(
+                "BasePass::resolveDrawKey [%s] - Mesh '%s' still not ready after queueing update. Skipping entity %lld.",
+                qPrintable(name()), qPrintable(meshId), entity);
+            return DrawKeyStatus::Pending;
+        }
+        qInfo() << "BasePass::resolveDrawKey [" << name() << "] - Mesh '" << meshId <<
+                "' successfully queued and marked ready.";
+    }
+    if (meshGpu && meshGpu->ready && matGpu && matGpu->ready && albedoTexGpu && albedoTexGpu->ready &&
+        meshGpu->vertexBuffer && meshGpu->indexBuffer) {
+        return DrawKeyStatus::Ready;
+    }
+
+    if (!meshGpu->ready)
+        qWarning() << "Skipping entity" << entity << "because mesh" << meshId << "not ready.";
+    else if (!matGpu || !matGpu->ready)
+        qWarning() << "Skipping entity" << entity << "because material" << materialCacheKey << "not ready.";
+    else if (!albedoTexGpu || !albedoTexGpu->ready)
+        qWarning() << "Skipping entity" << entity << "because albedo texture" << (
+            matGpu ? matGpu->albedoId : "N/A") << "not ready.";
+    else if (!meshGpu->vertexBuffer)
+        qWarning() << "Skipping entity" << entity << "because mesh" << meshId << "vertex buffer is null.";
+    else if (!meshGpu->indexBuffer)
+        qWarning() << "Skipping entity" << entity << "because mesh" << meshId << "index buffer is null.";
+    return DrawKeyStatus::Pending;
+}
 
-            // 绘制实例
-            if (!entitiesInBatch.isEmpty()) {
-                cmdBuffer->drawIndexed(meshGpu->indexCount, currentBatchInstanceCount);
+void BasePass::layoutDrawBatches(const RenderSceneFrame &frame) {
+    // 实例数据按绘制顺序排布，每个批次占据 [firstInstance, firstInstance + instanceCount) 的连续区间
+    mDrawBatches.clear();
+    mInstanceIndexByEntity.clear();
+    mInstanceCount = 0;
+    QVector<EntityID> instanceEntities;
+    instanceEntities.reserve(qMin<qsizetype>(mDrawSlotByEntity.size(), mMaxInstances));
+    bool truncated = false;
+    for (auto meshIt = mEntitiesByMeshThenMaterial.constBegin(); meshIt != mEntitiesByMeshThenMaterial.constEnd();
+         ++meshIt) {
+        for (auto matIt = meshIt.value().constBegin(); matIt != meshIt.value().constEnd(); ++matIt) {
+            const qint32 count = qMin<qint32>(matIt.value().size(), mMaxInstances - mInstanceCount);
+            if (count < matIt.value().size()) {
+                truncated = true;
             }
-
-            totalInstancesDrawnThisPass += currentBatchInstanceCount;
+            if (count <= 0) continue;
+            DrawBatch drawBatch{meshIt.key(), matIt.key(), mInstanceCount, count};
+            for (qint32 i = 0; i < count; ++i) {
+                const EntityID entity = matIt.value()[i];
+                mInstanceIndexByEntity.insert(entity, mInstanceCount);
+                instanceEntities.append(entity);
+                ++mInstanceCount;
+            }
+            mDrawBatches.append(drawBatch);
         }
     }
-    if (totalInstancesDrawnThisPass != currentInstanceIndex) {
-        qWarning(
-            "Mismatch between instances prepared (%d) and instances submitted for drawing (%d). Check skipping logic.",
-            currentInstanceIndex, totalInstancesDrawnThisPass);
-    } else {
-        qInfo() << "BasePass submitted" << totalInstancesDrawnThisPass << "instances.";
+    if (truncated) {
+        qWarning("BasePass::layoutDrawBatches [%s] - Exceeded max instances (%d). Some objects may not be drawn.",
+                 qPrintable(name()), mMaxInstances);
     }
-    // End Render Pass
-    cmdBuffer->endPass();
+
+    InstanceUniformBlock *instances = mInstanceDataBuffer.data();
+    InstanceNormalUniformBlock *normals = mInstanceNormalBuffer.data();
+    JobSystem::getInstance()->parallelFor(instanceEntities.size(), 512, [&](qint32 begin, qint32 end) {
+        for (qint32 i = begin; i < end; ++i) {
+            const RenderInstanceProxy *proxy = frame.findInstance(instanceEntities[i]);
+            instances[i] = proxy->instance;
+            normals[i] = proxy->normal;
+        }
+    });
 }
 
-void BasePass::updateUniforms(QRhiResourceUpdateBatch *batch) {
-    if (!mWorld || !mCameraUboRef.isValid() || !mLightingUboRef.isValid() || !mRhi) {
-        qWarning("BasePass::updateUniforms - World or UBO refs are invalid.");
+void BasePass::updateUniforms(QRhiResourceUpdateBatch *batch, const RenderSceneFrame &frame) {
+    if (!mCameraUboRef.isValid() || !mLightingUboRef.isValid() || !mRhi) {
+        qWarning("BasePass::updateUniforms - UBO refs are invalid.");
         return;
     }
 
@@ -522,94 +664,37 @@ void BasePass::updateUniforms(QRhiResourceUpdateBatch *batch) {
 
     // --- Update Camera UBO ---
     CameraUniformBlock camData;
-    bool cameraFoundAndValid = false;
-    if (mActiveCamera == INVALID_ENTITY) {
-        findActiveCamera();
-    }
-
-    if (mActiveCamera != INVALID_ENTITY) {
-        auto *camComp = mWorld->getComponent<CameraComponent>(mActiveCamera);
-        auto *camTf = mWorld->getComponent<TransformComponent>(mActiveCamera);
-        if (camComp && camTf) {
-            QMatrix4x4 viewMatrix;
-            QVector3D eye = camTf->position();
-            QVector3D center = eye + camTf->forward();
-            QVector3D up = camTf->up();
-            viewMatrix.lookAt(eye, center, up);
-
-            QMatrix4x4 projMatrix;
-            const QSize outputPixelSize = mOutput.baseColor.pixelSize(); // Use graph output size
-            float aspect = 1.0f;
-            if (outputPixelSize.isValid() && outputPixelSize.height() > 0) {
-                aspect = outputPixelSize.width() / (float) outputPixelSize.height();
-            } else {
-                qWarning("BasePass::updateUniforms - Invalid output size for aspect ratio calculation.");
-            }
-            projMatrix.perspective(camComp->mFov, aspect, camComp->mNearPlane, camComp->mFarPlane);
-            projMatrix *= mRhi->clipSpaceCorrMatrix(); // Apply correction matrix
-
-            camData.view = viewMatrix.toGenericMatrix<4, 4>();
-            camData.projection = projMatrix.toGenericMatrix<4, 4>();
-            camData.viewPos = camTf->position();
-            cameraFoundAndValid = true;
+    const RenderCameraProxy &camera = frame.camera;
+    if (camera.isValid()) {
+        QMatrix4x4 viewMatrix;
+        viewMatrix.lookAt(camera.position, camera.position + camera.forward, camera.up);
+
+        QMatrix4x4 projMatrix;
+        const QSize outputPixelSize = mOutput.baseColor.pixelSize(); // Use graph output size
+        float aspect = 1.0f;
+        if (outputPixelSize.isValid() && outputPixelSize.height() > 0) {
+            aspect = outputPixelSize.width() / (float) outputPixelSize.height();
         } else {
-            qWarning(
-                "BasePass::updateUniforms - Active camera entity %lld missing CameraComponent or TransformComponent.",
-                mActiveCamera);
-            mActiveCamera = INVALID_ENTITY;
+            qWarning("BasePass::updateUniforms - Invalid output size for aspect ratio calculation.");
         }
-    }
-    if (!cameraFoundAndValid) {
-        qWarning("BasePass::updateUniforms - Using default camera matrices.");
+        projMatrix.perspective(camera.fov, aspect, camera.nearPlane, camera.farPlane);
+        projMatrix *= mRhi->clipSpaceCorrMatrix(); // Apply correction matrix
+
+        camData.view = viewMatrix.toGenericMatrix<4, 4>();
+        camData.projection = projMatrix.toGenericMatrix<4, 4>();
+        camData.viewPos = camera.position;
+    } else {
+        qWarning("BasePass::updateUniforms - No active camera in render scene, using default camera matrices.");
         QMatrix4x4 identity;
         camData.view = identity.toGenericMatrix<4, 4>();
         camData.projection = identity.toGenericMatrix<4, 4>();
         camData.viewPos = QVector3D(0, 0, 5);
     }
-    batch->updateDynamicBuffer(mCameraUboRef.get(), 0, sizeof(CameraUniformBlock), &camData);
+    batch->updateDynamicBuffer(cameraUbo, 0, sizeof(CameraUniformBlock), &camData);
 
     // --- 更新 Lighting UBO ---
-    LightingUniformBlock lightData;
-    memset(&lightData, 0, sizeof(LightingUniformBlock));
-    int pointLightCount = 0;
-    bool dirLightSet = false;
-
-    for (EntityID entity: mWorld->view<LightComponent, TransformComponent>()) {
-        auto *lightComp = mWorld->getComponent<LightComponent>(entity);
-        auto *lightTf = mWorld->getComponent<TransformComponent>(entity);
-        if (!lightComp || !lightTf) continue;
-
-        switch (lightComp->type) {
-            case LightType::Directional:
-                if (!dirLightSet) {
-                    lightData.dirLight.direction = lightTf->rotation().rotatedVector({0, 0, -1}).normalized();
-                    lightData.dirLight.color = lightComp->color * lightComp->intensity;
-                    lightData.dirLight.enabled = 1;
-                    dirLightSet = true;
-                } else {
-                    qWarning("BasePass::updateUniforms - Multiple directional lights found. Using the first one.");
-                }
-                break;
-            case LightType::Point:
-                if (pointLightCount < MAX_POINT_LIGHTS) {
-                    auto &pl = lightData.pointLights[pointLightCount];
-                    pl.position = lightTf->position();
-                    pl.color = lightComp->color * lightComp->intensity;
-                    pl.constant = lightComp->constantAttenuation;
-                    pl.linear = lightComp->linearAttenuation;
-                    pl.quadratic = lightComp->quadraticAttenuation;
-                    pointLightCount++;
-                } else {
-                    qWarning("BasePass::updateUniforms - Exceeded maximum point lights (%d).", MAX_POINT_LIGHTS);
-                }
-                break;
-        }
-    }
-    lightData.numPointLights = pointLightCount;
-    if (!dirLightSet) {
-        lightData.dirLight.enabled = 0;
-    }
-    batch->updateDynamicBuffer(mLightingUboRef.get(), 0, sizeof(LightingUniformBlock), &lightData);
+    // 灯光在发布快照时已按 UBO 布局收集好
+    batch->updateDynamicBuffer(lightingUbo, 0, sizeof(LightingUniformBlock), &frame.lighting);
 }
 
 void BasePass::uploadInstanceData(QRhiResourceUpdateBatch *batch, int instanceCount) {
@@ -638,6 +723,9 @@ void BasePass::uploadInstanceData(QRhiResourceUpdateBatch *batch, int instanceCo
 
         if (instanceCount > 0) {
             batch->updateDynamicBuffer(instanceUbo, 0, dataSize, mInstanceDataBuffer.constData());
+            if (QRhiBuffer *instanceNormalUbo = mInstanceNormalUboRef.get()) {
+                batch->updateDynamicBuffer(instanceNormalUbo, 0, dataSize, mInstanceNormalBuffer.constData());
+            }
         }
     } else if (instanceCount > mMaxInstances) {
         qWarning(
@@ -645,23 +733,3 @@ void BasePass::uploadInstanceData(QRhiResourceUpdateBatch *batch, int instanceCo
             instanceCount, mMaxInstances);
     }
 }
-
-void BasePass::findActiveCamera() {
-    if (!mWorld) {
-        qWarning("BasePass::findActiveCamera - World is null.");
-        mActiveCamera = INVALID_ENTITY;
-        return;
-    }
-    mActiveCamera = INVALID_ENTITY;
-    for (EntityID entity: mWorld->view<CameraComponent, TransformComponent>()) {
-        // if (mWorld->hasComponent<ActiveCameraTag>(entity)) {
-        mActiveCamera = entity;
-        qInfo() << "BasePass: Found active camera entity:" << mActiveCamera;
-        break;
-        // }
-    }
-
-    if (mActiveCamera == INVALID_ENTITY) {
-        qWarning("BasePass::findActiveCamera - No active camera entity found in the world!");
-    }
-}
@@ -21,8 +21,8 @@ void PresentPass::setup(RGBuilder &builder) {
     // --- 声明输入依赖 ---
     mInput.sourceTexture = builder.readTexture("BaseColor");
     if (!mInput.sourceTexture.isValid()) {
-        qCritical(
-            "PresentPass::setup - Failed to declare read dependency on texture 'BaseColor'. Did BasePass run setup?");
+        // BaseColor 的写入方还没有 setup，compile() 会在它之后再次调用本 pass 的 setup
+        qInfo("PresentPass::setup - Texture 'BaseColor' is not available yet, setup deferred.");
         return;
     }
     qInfo() << "  Declared Read: RGTexture 'BaseColor'";
@@ -13,19 +13,28 @@ RGBuilder::RGBuilder(RenderGraph *rg, RGPass *currentPass)
 
 RGTextureRef RGBuilder::createTexture(const QString &name, const QSize &size, QRhiTexture::Format format,
                                       int sampleCount, QRhiTexture::Flags flags) {
+    return createTexture(name, RGSize::fixed(size), format, sampleCount, flags);
+}
+
+RGTextureRef RGBuilder::createTexture(const QString &name, const RGSize &sizeSpec, QRhiTexture::Format format,
+                                      int sampleCount, QRhiTexture::Flags flags) {
+    mCurrentPass->mUsedResources.insert(name);
+    const QSize size = sizeSpec.resolve(outputSize());
     // 确保Graph名字唯一
     QSharedPointer<RGResource> existingRes = mGraph->findResource(name);
     if (existingRes) {
         if (auto texRes = qSharedPointerCast<RGTexture>(existingRes)) {
             if (texRes->size() != size || texRes->format() != format || texRes->sampleCount() != sampleCount || texRes->
                 flags() != flags) {
-                qWarning(
-                    "RGBuilder::createTexture: Resource '%s' exists but with DIFFERENT parameters. Returning existing. Potential issues may arise.",
-                    qPrintable(name));
+                // 重新 setup 时描述变化（例如输出尺寸改变），原地更新描述，compile() 按哈希重建它和依赖它的资源
+                qInfo("RGBuilder::createTexture: Resource '%s' description changed, updating in place.",
+                      qPrintable(name));
+                *texRes = RGTexture(name, size, format, sampleCount, flags);
             } else {
                 qDebug("RGBuilder::createTexture: Resource '%s' already exists with same parameters.",
                        qPrintable(name));
             }
+            texRes->setSizeSpec(sizeSpec);
             return RGTextureRef(texRes);
         }
         qCritical("RGBuilder::createTexture: Resource name '%s' already exists but is NOT a Texture (Type: %d)!",
@@ -33,19 +42,21 @@ RGTextureRef RGBuilder::createTexture(const QString &name, const QSize &size, QR
         return RGTextureRef();
     }
     QSharedPointer<RGTexture> texResource = QSharedPointer<RGTexture>::create(name, size, format, sampleCount, flags);
+    texResource->setSizeSpec(sizeSpec);
     mGraph->registerResource(texResource);
     return RGTextureRef(texResource);
 }
 
 RGBufferRef RGBuilder::createBuffer(const QString &name, QRhiBuffer::Type type, QRhiBuffer::UsageFlags usage,
                                     quint32 size) {
+    mCurrentPass->mUsedResources.insert(name);
     QSharedPointer<RGResource> existingRes = mGraph->findResource(name);
     if (existingRes) {
         if (auto bufRes = qSharedPointerCast<RGBuffer>(existingRes)) {
             if (bufRes->bufType() != type || bufRes->usage() != usage || bufRes->size() != size) {
-                qWarning(
-                    "RGBuilder::createBuffer: Resource '%s' exists but with DIFFERENT parameters. Returning existing.",
-                    qPrintable(name));
+                qInfo("RGBuilder::createBuffer: Resource '%s' description changed, updating in place.",
+                      qPrintable(name));
+                *bufRes = RGBuffer(name, type, usage, size);
             }
             return RGBufferRef(bufRes);
         }
@@ -66,6 +77,7 @@ RGSamplerRef RGBuilder::setupSampler(const QString &name,
                                      QRhiSampler::AddressMode addressU,
                                      QRhiSampler::AddressMode addressV,
                                      QRhiSampler::AddressMode addressW) {
+    mCurrentPass->mUsedResources.insert(name);
     QSharedPointer<RGResource> existingRes = mGraph->findResource(name);
     if (existingRes) {
         if (auto samplerRes = qSharedPointerCast<RGSampler>(existingRes)) {
@@ -73,9 +85,9 @@ RGSamplerRef RGBuilder::setupSampler(const QString &name,
                 != mipmapMode ||
                 samplerRes->addressU() != addressU || samplerRes->addressV() != addressV || samplerRes->addressW() !=
                 addressW) {
-                qWarning(
-                    "RGBuilder::setupSampler: Resource '%s' exists but with DIFFERENT parameters. Returning existing.",
-                    qPrintable(name));
+                qInfo("RGBuilder::setupSampler: Resource '%s' description changed, updating in place.",
+                      qPrintable(name));
+                *samplerRes = RGSampler(name, magFilter, minFilter, mipmapMode, addressU, addressV, addressW);
             }
             return RGSamplerRef(samplerRes);
         }
@@ -92,15 +104,24 @@ RGSamplerRef RGBuilder::setupSampler(const QString &name,
 
 RGRenderBufferRef RGBuilder::setupRenderBuffer(const QString &name, QRhiRenderBuffer::Type type, const QSize &size,
                                                int sampleCount, QRhiRenderBuffer::Flags flags) {
+    return setupRenderBuffer(name, type, RGSize::fixed(size), sampleCount, flags);
+}
+
+RGRenderBufferRef RGBuilder::setupRenderBuffer(const QString &name, QRhiRenderBuffer::Type type,
+                                               const RGSize &sizeSpec, int sampleCount,
+                                               QRhiRenderBuffer::Flags flags) {
+    mCurrentPass->mUsedResources.insert(name);
+    const QSize size = sizeSpec.resolve(outputSize());
     QSharedPointer<RGResource> existingRes = mGraph->findResource(name);
     if (existingRes) {
         if (auto rbRes = qSharedPointerCast<RGRenderBuffer>(existingRes)) {
             if (rbRes->rbType() != type || rbRes->size() != size || rbRes->sampleCount() != sampleCount || rbRes->
                 flags() != flags) {
-                qWarning(
-                    "RGBuilder::setupRenderBuffer: Resource '%s' exists but with DIFFERENT parameters. Returning existing.",
-                    qPrintable(name));
+                qInfo("RGBuilder::setupRenderBuffer: Resource '%s' description changed, updating in place.",
+                      qPrintable(name));
+                *rbRes = RGRenderBuffer(name, type, size, sampleCount, flags);
             }
+            rbRes->setSizeSpec(sizeSpec);
             return RGRenderBufferRef(rbRes);
         }
         qCritical(
@@ -109,17 +130,22 @@ RGRenderBufferRef RGBuilder::setupRenderBuffer(const QString &name, QRhiRenderBu
         return RGRenderBufferRef();
     }
     auto rbResource = QSharedPointer<RGRenderBuffer>::create(name, type, size, sampleCount, flags);
+    rbResource->setSizeSpec(sizeSpec);
     mGraph->registerResource(rbResource);
     return RGRenderBufferRef(rbResource);
 }
 
 RGRenderTargetRef RGBuilder::setupRenderTarget(const QString &name, const QVector<RGTextureRef> &colorRefs,
                                                RGResourceRef dsRef) {
+    mCurrentPass->mUsedResources.insert(name);
     QSharedPointer<RGResource> existingRes = mGraph->findResource(name);
     if (existingRes) {
         if (auto rtRes = qSharedPointerCast<RGRenderTarget>(existingRes)) {
-            qWarning("RGBuilder::setupRenderTarget: Resource '%s' already exists. Returning existing.",
-                     qPrintable(name));
+            if (rtRes->colorAttachmentRefs() != colorRefs || rtRes->depthStencilAttachmentRef() != dsRef) {
+                qInfo("RGBuilder::setupRenderTarget: Resource '%s' attachments changed, updating in place.",
+                      qPrintable(name));
+                rtRes->setAttachments(colorRefs, dsRef);
+            }
             return RGRenderTargetRef(rtRes);
         }
         qCritical(
@@ -143,6 +169,9 @@ RGRenderTargetRef RGBuilder::setupRenderTarget(const QString &name, const QVecto
 }
 
 RGRenderTargetRef RGBuilder::getRenderTarget(const QString &name) {
+    mCurrentPass->mUsedResources.insert(name);
+    // 取用已有的 render target 用来渲染，视为写入
+    mCurrentPass->mWrites.insert(name);
     QSharedPointer<RGResource> res = mGraph->findResource(name);
     if (res) {
         if (auto rtRes = qSharedPointerCast<RGRenderTarget>(res)) {
@@ -158,11 +187,15 @@ RGRenderTargetRef RGBuilder::getRenderTarget(const QString &name) {
 
 RGShaderResourceBindingsRef RGBuilder::setupShaderResourceBindings(const QString &name,
                                                                    const QVector<QRhiShaderResourceBinding> &bindings) {
+    mCurrentPass->mUsedResources.insert(name);
     QSharedPointer<RGResource> existingRes = mGraph->findResource(name);
     if (existingRes) {
         if (auto srbRes = qSharedPointerCast<RGShaderResourceBindings>(existingRes)) {
-            qWarning("RGBuilder::setupShaderResourceBindings: Resource '%s' already exists. Returning existing.",
-                     qPrintable(name));
+            if (srbRes->bindings() != bindings) {
+                qInfo("RGBuilder::setupShaderResourceBindings: Resource '%s' bindings changed, updating in place.",
+                      qPrintable(name));
+                *srbRes = RGShaderResourceBindings(name, bindings);
+            }
             return RGShaderResourceBindingsRef(srbRes);
         }
         qCritical(
@@ -177,16 +210,26 @@ RGShaderResourceBindingsRef RGBuilder::setupShaderResourceBindings(const QString
 
 RGTextureRef RGBuilder::writeTexture(const QString &name, const QSize &size, QRhiTexture::Format format,
                                      int sampleCount, QRhiTexture::Flags flags) {
+    return writeTexture(name, RGSize::fixed(size), format, sampleCount, flags);
+}
+
+RGTextureRef RGBuilder::writeTexture(const QString &name, const RGSize &size, QRhiTexture::Format format,
+                                     int sampleCount, QRhiTexture::Flags flags) {
     qDebug() << "RGBuilder: Pass" << mCurrentPass->name() << "writes Texture" << name;
+    mCurrentPass->mWrites.insert(name);
     return createTexture(name, size, format, sampleCount, flags);
 }
 
 RGTextureRef RGBuilder::readTexture(const QString &name) {
+    mCurrentPass->mUsedResources.insert(name);
     qDebug() << "RGBuilder: Pass" << mCurrentPass->name() << "reads Texture" << name;
+    mCurrentPass->mReads.insert(name);
     QSharedPointer<RGResource> res = mGraph->findResource(name);
     if (!res) {
-        qWarning("RGBuilder::readTexture - Resource '%s' not found in the graph. Pass '%s' cannot read it.",
-                 qPrintable(name), qPrintable(mCurrentPass->name()));
+        // 写入方可能还没有 setup，由 compile() 在写入方之后重试
+        qDebug("RGBuilder::readTexture - Resource '%s' not found in the graph yet. Pass '%s' will be set up again.",
+               qPrintable(name), qPrintable(mCurrentPass->name()));
+        mCurrentPass->mUnresolvedReads.insert(name);
         return RGTextureRef();
     }
     if (auto texRes = qSharedPointerCast<RGTexture>(res)) {
@@ -198,16 +241,24 @@ RGTextureRef RGBuilder::readTexture(const QString &name) {
 }
 
 RGRenderBufferRef RGBuilder::writeDepthStencil(const QString &name, const QSize &size, int sampleCount) {
+    return writeDepthStencil(name, RGSize::fixed(size), sampleCount);
+}
+
+RGRenderBufferRef RGBuilder::writeDepthStencil(const QString &name, const RGSize &size, int sampleCount) {
     qDebug() << "RGBuilder: Pass" << mCurrentPass->name() << "writes DepthStencil" << name;
+    mCurrentPass->mWrites.insert(name);
     return setupRenderBuffer(name, QRhiRenderBuffer::DepthStencil, size, sampleCount);
 }
 
 RGRenderBufferRef RGBuilder::readDepthStencil(const QString &name) {
+    mCurrentPass->mUsedResources.insert(name);
     qDebug() << "RGBuilder: Pass" << mCurrentPass->name() << "reads DepthStencil" << name;
+    mCurrentPass->mReads.insert(name);
     QSharedPointer<RGResource> res = mGraph->findResource(name);
     if (!res) {
-        qWarning("RGBuilder::readDepthStencil - Resource '%s' not found. Pass '%s' cannot read it.", qPrintable(name),
-                 qPrintable(mCurrentPass->name()));
+        qDebug("RGBuilder::readDepthStencil - Resource '%s' not found yet. Pass '%s' will be set up again.",
+               qPrintable(name), qPrintable(mCurrentPass->name()));
+        mCurrentPass->mUnresolvedReads.insert(name);
         return RGRenderBufferRef();
     }
     if (auto rbRes = qSharedPointerCast<RGRenderBuffer>(res)) {
@@ -242,18 +293,7 @@ RGPipelineRef RGBuilder::setupGraphicsPipeline(const QString &name,
                                                QRhiGraphicsPipeline::PolygonMode polygonMode,
                                                float lineWidth, int patchControlPoints, int depthBias,
                                                float slopeScaledDepthBias) {
-    QSharedPointer<RGResource> existingRes = mGraph->findResource(name);
-    if (existingRes) {
-        if (auto pipeRes = qSharedPointerCast<RGPipeline>(existingRes)) {
-            qWarning("RGBuilder::setupGraphicsPipeline: Resource '%s' already exists. Returning existing.",
-                     qPrintable(name));
-            return RGPipelineRef(pipeRes);
-        }
-        qCritical(
-            "RGBuilder::setupGraphicsPipeline: Resource name '%s' already exists but is NOT a Pipeline (Type: %d)!",
-            qPrintable(name), static_cast<int>(existingRes->type()));
-        return RGPipelineRef();
-    }
+    mCurrentPass->mUsedResources.insert(name);
     // --- 验证依赖 ---
     if (!srbLayoutRef.isValid()) {
         qWarning("RGBuilder::setupGraphicsPipeline '%s': Invalid ShaderResourceBindings reference provided.",
@@ -299,6 +339,21 @@ RGPipelineRef RGBuilder::setupGraphicsPipeline(const QString &name,
         frontFace, depthTest, depthWrite, depthOp, stencilTest, stencilFront, stencilBack, stencilReadMask,
         stencilWriteMask, targetBlends, polygonMode, lineWidth, patchControlPoints, depthBias, slopeScaledDepthBias);
 
+    QSharedPointer<RGResource> existingRes = mGraph->findResource(name);
+    if (existingRes) {
+        if (auto pipeRes = qSharedPointerCast<RGPipeline>(existingRes)) {
+            if (pipeRes->descriptorHash() != pipelineResource->descriptorHash()) {
+                qInfo("RGBuilder::setupGraphicsPipeline: Resource '%s' description changed, updating in place.",
+                      qPrintable(name));
+                *pipeRes = *pipelineResource;
+            }
+            return RGPipelineRef(pipeRes);
+        }
+        qCritical(
+            "RGBuilder::setupGraphicsPipeline: Resource name '%s' already exists but is NOT a Pipeline (Type: %d)!",
+            qPrintable(name), static_cast<int>(existingRes->type()));
+        return RGPipelineRef();
+    }
     mGraph->registerResource(pipelineResource);
     return RGPipelineRef(pipelineResource);
 }
@@ -315,6 +370,10 @@ QSharedPointer<World> RGBuilder::world() const {
     return mGraph->getWorld();
 }
 
+QSharedPointer<RenderScene> RGBuilder::renderScene() const {
+    return mGraph->getRenderScene();
+}
+
 const QSize &RGBuilder::outputSize() const {
     return mGraph->getOutputSize();
 }
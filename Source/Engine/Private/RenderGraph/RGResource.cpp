@@ -1,5 +1,7 @@
 #include "RenderGraph/RGResource.h"
 
+#include <QHashFunctions>
+
 bool RGTexture::build(QRhi *inRhi) {
     if (!mSize.isValid() || mSize.width() <= 0 || mSize.height() <= 0) {
         qWarning("RGTexture::build - Cannot build texture '%s' with invalid size: %dx%d", qPrintable(name()),
@@ -29,6 +31,19 @@ bool RGTexture::build(QRhi *inRhi) {
     return false;
 }
 
+bool RGTexture::resizeToOutput(const QSize &outputSize) {
+    if (!mSizeSpec.isRelative) return false;
+    const QSize size = mSizeSpec.resolve(outputSize);
+    if (size == mSize) return false;
+    mSize = size;
+    return true;
+}
+
+size_t RGTexture::descriptorHash() const {
+    return qHashMulti(0, static_cast<int>(type()), mSize.width(), mSize.height(), static_cast<int>(mFormat),
+                      mSampleCount, mFlags.toInt());
+}
+
 bool RGBuffer::build(QRhi *inRhi) {
     if (mRhiBuffer && mRhiBuffer->type() == mBufType && mRhiBuffer->usage() == mUsage && mRhiBuffer->size() == mSize) {
         return true;
@@ -51,6 +66,10 @@ bool RGBuffer::build(QRhi *inRhi) {
     return false;
 }
 
+size_t RGBuffer::descriptorHash() const {
+    return qHashMulti(0, static_cast<int>(type()), static_cast<int>(mBufType), mUsage.toInt(), mSize);
+}
+
 bool RGRenderBuffer::build(QRhi *inRhi) {
     if (!mSize.isValid() || mSize.width() <= 0 || mSize.height() <= 0) {
         qWarning("RGRenderBuffer::build - Cannot build render buffer '%s' with invalid size: %dx%d", qPrintable(name()),
@@ -79,6 +98,19 @@ bool RGRenderBuffer::build(QRhi *inRhi) {
     return false;
 }
 
+bool RGRenderBuffer::resizeToOutput(const QSize &outputSize) {
+    if (!mSizeSpec.isRelative) return false;
+    const QSize size = mSizeSpec.resolve(outputSize);
+    if (size == mSize) return false;
+    mSize = size;
+    return true;
+}
+
+size_t RGRenderBuffer::descriptorHash() const {
+    return qHashMulti(0, static_cast<int>(type()), static_cast<int>(mRbType), mSize.width(), mSize.height(),
+                      mSampleCount, mFlags.toInt());
+}
+
 RGRenderTarget::RGRenderTarget(const QString &name, const QVector<RGTextureRef> &colorAttachmentRefs,
                                RGResourceRef depthStencilRef)
     : RGResource(name, Type::RenderTarget),
@@ -121,10 +153,7 @@ bool RGRenderTarget::build(QRhi *inRhi) {
     // --- 构建内部渲染目标 ---
     qInfo() << "RGRenderTarget::build - Building internal QRhiRenderTarget for:" << name();
 
-    if (mRpDescOwned) {
-        mRpDescOwned.reset();
-    }
-    mRpDesc = nullptr;
+    // 保留旧的 render pass 描述，新建的 render target 与它兼容时继续沿用，引用它的管线保持有效
     if (mRhiRenderTarget) {
         mRhiRenderTarget.reset();
     }
@@ -195,19 +224,61 @@ bool RGRenderTarget::build(QRhi *inRhi) {
         mRhiRenderTarget.reset(); // Release the unusable RT object
         return false;
     }
-    mRpDescOwned.reset(textureRT->newCompatibleRenderPassDescriptor());
-    if (!mRpDescOwned) {
+    QScopedPointer<QRhiRenderPassDescriptor> rpDesc(textureRT->newCompatibleRenderPassDescriptor());
+    if (!rpDesc) {
         qWarning("RGRenderTarget::build - Failed to create compatible RenderPassDescriptor for %s", qPrintable(name()));
         mRhiRenderTarget.reset();
         return false;
     }
-    mRpDescOwned->setName(name().toUtf8() + "_RpDesc");
+    if (!mRpDescOwned || !mRpDescOwned->isCompatible(rpDesc.get())) {
+        rpDesc->setName(name().toUtf8() + "_RpDesc");
+        mRpDescOwned.swap(rpDesc);
+    }
     mRpDesc = mRpDescOwned.get();
     mRhiRenderTarget->setRenderPassDescriptor(mRpDesc);
     qInfo() << "  Successfully created RHI RenderTarget:" << name() << "and its owned RenderPassDescriptor.";
     return true;
 }
 
+size_t RGRenderTarget::descriptorHash() const {
+    if (mIsExternalRpDesc) {
+        return qHashMulti(0, static_cast<int>(type()), reinterpret_cast<quintptr>(mRpDesc));
+    }
+    size_t seed = qHash(static_cast<int>(type()));
+    for (const RGTextureRef &colorRef: mColorAttachmentRefs) {
+        seed = colorRef.mResource ? qHashMulti(seed, colorRef.mResource->name(), colorRef.mResource->descriptorHash())
+                                  : qHash(0, seed);
+    }
+    if (mDepthStencilAttachmentRef.mResource) {
+        seed = qHashMulti(seed, mDepthStencilAttachmentRef.mResource->name(),
+                          mDepthStencilAttachmentRef.mResource->descriptorHash());
+    }
+    return seed;
+}
+
+size_t RGRenderTarget::formatHash() const {
+    if (mIsExternalRpDesc) {
+        return qHashMulti(0, static_cast<int>(type()), reinterpret_cast<quintptr>(mRpDesc));
+    }
+    size_t seed = qHash(static_cast<int>(type()));
+    for (const RGTextureRef &colorRef: mColorAttachmentRefs) {
+        seed = qHashMulti(seed, static_cast<int>(colorRef.format()), colorRef.sampleCount());
+    }
+    if (auto depthStencil = qSharedPointerCast<RGRenderBuffer>(mDepthStencilAttachmentRef.mResource)) {
+        seed = qHashMulti(seed, static_cast<int>(depthStencil->rbType()), depthStencil->sampleCount(),
+                          depthStencil->flags().toInt());
+    }
+    return seed;
+}
+
+void RGRenderTarget::setAttachments(const QVector<RGTextureRef> &colorAttachmentRefs, RGResourceRef depthStencilRef) {
+    mColorAttachmentRefs = colorAttachmentRefs;
+    mDepthStencilAttachmentRef = std::move(depthStencilRef);
+    mRhiRenderTarget.reset();
+    mRpDescOwned.reset();
+    mRpDesc = nullptr;
+}
+
 QRhiRenderPassDescriptor *RGRenderTarget::renderPassDescriptor() const {
     if (!mRpDesc) {
         qWarning("RGRenderTarget::renderPassDescriptor() called for '%s', but mRpDesc is null. External: %d",
@@ -370,6 +441,42 @@ bool RGPipeline::build(QRhi *inRhi) {
     return false;
 }
 
+size_t RGPipeline::descriptorHash() const {
+    size_t seed = qHash(static_cast<int>(type()));
+    if (mSrbLayoutRef.mResource) {
+        seed = qHashMulti(seed, mSrbLayoutRef.mResource->name(), mSrbLayoutRef.mResource->descriptorHash());
+    }
+    // render target 只取格式部分，尺寸变化后重建的 render target 沿用兼容的 render pass 描述，管线不必重建
+    if (mRenderTargetRef.mResource) {
+        seed = qHashMulti(seed, mRenderTargetRef.mResource->name(),
+                          static_cast<const RGRenderTarget *>(mRenderTargetRef.mResource.get())->formatHash());
+    }
+    for (const QRhiShaderStage &stage: mShaderStages) {
+        seed = qHashMulti(seed, static_cast<int>(stage.type()), stage.shader(),
+                          static_cast<int>(stage.shaderVariant()));
+    }
+    for (auto it = mVertexInputLayout.cbeginBindings(); it != mVertexInputLayout.cendBindings(); ++it) {
+        seed = qHashMulti(seed, it->stride(), static_cast<int>(it->classification()), it->instanceStepRate());
+    }
+    for (auto it = mVertexInputLayout.cbeginAttributes(); it != mVertexInputLayout.cendAttributes(); ++it) {
+        seed = qHashMulti(seed, it->binding(), it->location(), static_cast<int>(it->format()), it->offset());
+    }
+    for (const QRhiGraphicsPipeline::StencilOpState &state: {mStencilFront, mStencilBack}) {
+        seed = qHashMulti(seed, static_cast<int>(state.failOp), static_cast<int>(state.depthFailOp),
+                          static_cast<int>(state.passOp), static_cast<int>(state.compareOp));
+    }
+    for (const QRhiGraphicsPipeline::TargetBlend &blend: mTargetBlends) {
+        seed = qHashMulti(seed, static_cast<int>(blend.colorWrite.toInt()), blend.enable,
+                          static_cast<int>(blend.srcColor), static_cast<int>(blend.dstColor),
+                          static_cast<int>(blend.opColor), static_cast<int>(blend.srcAlpha),
+                          static_cast<int>(blend.dstAlpha), static_cast<int>(blend.opAlpha));
+    }
+    return qHashMulti(seed, mSampleCount, static_cast<int>(mTopology), static_cast<int>(mCullMode),
+                      static_cast<int>(mFrontFace), mDepthTest, mDepthWrite, static_cast<int>(mDepthOp), mStencilTest,
+                      mStencilReadMask, mStencilWriteMask, static_cast<int>(mPolygonMode), mLineWidth,
+                      mPatchControlPoints, mDepthBias, mSlopeScaledDepthBias);
+}
+
 QRhiRenderPassDescriptor *RGPipeline::rpDesc() const {
     if (mRenderTargetRef.isValid() && mRenderTargetRef.mResource) {
         return static_cast<RGRenderTarget *>(mRenderTargetRef.mResource.get())->renderPassDescriptor();
@@ -399,6 +506,10 @@ bool RGShaderResourceBindings::build(QRhi *inRhi) {
     return false;
 }
 
+size_t RGShaderResourceBindings::descriptorHash() const {
+    return qHashRange(mBindings.cbegin(), mBindings.cend(), qHash(static_cast<int>(type())));
+}
+
 bool RGSampler::build(QRhi *inRhi) {
     if (mRhiSampler && mRhiSampler->magFilter() == mMagFilter && mRhiSampler->minFilter() == mMinFilter && mRhiSampler->
         mipmapMode() == mMipmapMode && mRhiSampler->addressU() == mAddressU && mRhiSampler->addressV() == mAddressV &&
@@ -421,3 +532,9 @@ bool RGSampler::build(QRhi *inRhi) {
     qWarning("RGSampler::build - Failed to allocate QRhiSampler object for %s", qPrintable(name()));
     return false;
 }
+
+size_t RGSampler::descriptorHash() const {
+    return qHashMulti(0, static_cast<int>(type()), static_cast<int>(mMagFilter), static_cast<int>(mMinFilter),
+                      static_cast<int>(mMipmapMode), static_cast<int>(mAddressU), static_cast<int>(mAddressV),
+                      static_cast<int>(mAddressW));
+}
@@ -1,9 +1,65 @@
 #include "RenderGraph/RenderGraph.h"
 
+#include <algorithm>
+#include <functional>
+#include <queue>
+
 #include "RenderGraph/RGBuilder.h"
 #include "RenderGraph/RGPass.h"
 #include "RenderGraph/RGResource.h"
 
+namespace {
+    // 估算用的每像素字节数，只用于统计别名节省的显存
+    qint64 bytesPerPixel(QRhiTexture::Format format) {
+        switch (format) {
+            case QRhiTexture::R8:
+            case QRhiTexture::RED_OR_ALPHA8:
+                return 1;
+            case QRhiTexture::RG8:
+            case QRhiTexture::R16:
+            case QRhiTexture::R16F:
+            case QRhiTexture::D16:
+                return 2;
+            case QRhiTexture::RGBA16F:
+                return 8;
+            case QRhiTexture::RGBA32F:
+                return 16;
+            default:
+                return 4;
+        }
+    }
+
+    qint64 estimateBytes(const RGResource *resource) {
+        if (resource->type() == RGResource::Type::Texture) {
+            const auto *texture = static_cast<const RGTexture *>(resource);
+            return qint64(texture->size().width()) * texture->size().height() * texture->sampleCount() *
+                   bytesPerPixel(texture->format());
+        }
+        const auto *renderBuffer = static_cast<const RGRenderBuffer *>(resource);
+        return qint64(renderBuffer->size().width()) * renderBuffer->size().height() * renderBuffer->sampleCount() * 4;
+    }
+
+    bool hasRhiObject(const RGResource *res) {
+        return res->mRhiTexture || res->mRhiBuffer || res->mRhiRenderBuffer || res->mRhiRenderTarget ||
+               res->mRhiGraphicsPipeline || res->mRhiShaderResourceBindings || res->mRhiSampler;
+    }
+
+    // 描述完全相同的纹理/渲染缓冲才能共用同一个 RHI 对象
+    bool canAlias(const RGResource *a, const RGResource *b) {
+        if (a->type() != b->type()) return false;
+        if (a->type() == RGResource::Type::Texture) {
+            const auto *ta = static_cast<const RGTexture *>(a);
+            const auto *tb = static_cast<const RGTexture *>(b);
+            return ta->size() == tb->size() && ta->format() == tb->format() &&
+                   ta->sampleCount() == tb->sampleCount() && ta->flags() == tb->flags();
+        }
+        const auto *ra = static_cast<const RGRenderBuffer *>(a);
+        const auto *rb = static_cast<const RGRenderBuffer *>(b);
+        return ra->rbType() == rb->rbType() && ra->size() == rb->size() && ra->sampleCount() == rb->sampleCount() &&
+               ra->flags() == rb->flags();
+    }
+}
+
 RenderGraph::RenderGraph(QRhi *rhi, QSharedPointer<ResourceManager> resManager, QSharedPointer<World> world,
                          const QSize &outputSize, QRhiRenderPassDescriptor *swapChainRpDesc)
     : mRhi(rhi), mResourceManager(resManager), mWorld(world), mOutputSize(outputSize),
@@ -34,6 +90,15 @@ RenderGraph::~RenderGraph() {
 }
 
 void RenderGraph::compile() {
+    if (mCompiled) {
+        if (mResizePending) {
+            applyOutputResize();
+        } else {
+            qDebug() << "RenderGraph::compile - Nothing invalidated since the last compile, skipped.";
+        }
+        return;
+    }
+    mResizePending = false;
     qInfo() << "RenderGraph::compile started...";
     if (!mOutputSize.isValid() || mOutputSize.width() <= 0 || mOutputSize.height() <= 0) {
         qCritical("RenderGraph::compile - Cannot compile with invalid output size: %dx%d. Compile aborted.",
@@ -42,28 +107,50 @@ void RenderGraph::compile() {
         return;
     }
     // --- 设置所有 Pass ---
-    // TODO 拓扑排序
     qInfo() << "  Running setup for" << mPasses.size() << "passes...";
-    mExecutionOrder.clear();
-    for (const auto &pass: qAsConst(mPasses)) {
-        if (pass) {
-            qInfo() << "    - Setting up pass:" << pass->name();
-            RGBuilder passBuilder(this, pass.get());
-            pass->setup(passBuilder);
-            mExecutionOrder.append(pass.get());
-        } else {
-            qWarning("  Found null pass pointer during setup.");
-        }
+    setupPasses();
+
+    // --- 剔除输出没有被用到的 pass ---
+    cullPasses();
+
+    // --- 拓扑排序 ---
+    if (!sortPasses()) {
+        mCompiled = false;
+        return;
     }
     qInfo() << "  Pass setup complete. Execution order size:" << mExecutionOrder.size();
 
+    // --- 瞬态资源别名 ---
+    aliasTransientResources();
+
+    // --- 比较描述哈希，只重建变化的资源 ---
+    const size_t previousGraphHash = mGraphHash;
+    const qint32 changedCount = releaseChangedResources();
+    bool allBuilt = true;
+    for (auto it = mResources.cbegin(); it != mResources.cend() && allBuilt; ++it) {
+        if (mCulledResources.contains(it.key()) || it.key() == "SwapChainRenderTargetProxy") continue;
+        allBuilt = hasRhiObject(it.value().get());
+    }
+    if (changedCount == 0 && mGraphHash == previousGraphHash && allBuilt) {
+        qInfo() << "RenderGraph::compile - Pass setups and resource descriptors unchanged, reusing RHI resources.";
+        mCompiled = true;
+        return;
+    }
+    qInfo() << "  " << changedCount << "resource descriptors changed since the last compile.";
+
+    mCompiled = createRhiResources();
+}
+
+bool RenderGraph::createRhiResources() {
     // --- 创建 RHI 资源 ---
-    qInfo() << "  Creating/Updating RHI resources for" << mResources.count() << "registered items...";
+    qInfo() << "  Creating/Updating RHI resources for" << mResources.count() - mCulledResources.size() <<
+            "registered items (" << mCulledResources.size() << "culled)...";
 
     // 阶段1：基本资源 (Textures, Buffers, Samplers, SRB Layouts)
     qInfo() << "    Phase 1: Basic Resources...";
     for (auto it = mResources.begin(); it != mResources.end(); ++it) {
         RGResource *res = it.value().get();
+        if (mCulledResources.contains(it.key()) || mAliasOwners.contains(it.key())) continue;
         switch (res->type()) {
             case RGResource::Type::Texture:
             case RGResource::Type::Buffer:
@@ -76,10 +163,20 @@ void RenderGraph::compile() {
                 break;
         }
     }
+    // 别名资源直接共用所有者的 RHI 对象
+    for (auto it = mAliasOwners.cbegin(); it != mAliasOwners.cend(); ++it) {
+        RGResource *alias = mResources.value(it.key()).get();
+        const RGResource *owner = mResources.value(it.value()).get();
+        if (alias && owner) {
+            alias->mRhiTexture = owner->mRhiTexture;
+            alias->mRhiRenderBuffer = owner->mRhiRenderBuffer;
+        }
+    }
     // 阶段2：Render Targets
     qInfo() << "    Phase 2: Render Targets...";
     for (auto it = mResources.begin(); it != mResources.end(); ++it) {
         RGResource *res = it.value().get();
+        if (mCulledResources.contains(it.key())) continue;
         if (res->type() == RGResource::Type::RenderTarget) {
             if (res->name() != "SwapChainRenderTargetProxy") {
                 createRhiResource(res);
@@ -90,6 +187,7 @@ void RenderGraph::compile() {
     // 阶段3：创建管线
     for (auto it = mResources.begin(); it != mResources.end(); ++it) {
         RGResource *res = it.value().get();
+        if (mCulledResources.contains(it.key())) continue;
         if (res && res->type() == RGResource::Type::Pipeline) {
             createRhiResource(res);
         }
@@ -99,17 +197,13 @@ void RenderGraph::compile() {
     int failedCount = 0;
     for (auto it = mResources.begin(); it != mResources.end(); ++it) {
         RGResource *res = it.value().get();
-        if (!res) continue;
+        if (!res || mCulledResources.contains(it.key())) continue;
         bool rhiObjectCreated = false;
         if (res->name() == "SwapChainRenderTargetProxy") {
             rhiObjectCreated = true;
         } else {
-            rhiObjectCreated = (res->mRhiTexture || res->mRhiBuffer || res->mRhiRenderBuffer ||
-                                res->mRhiRenderTarget || res->mRhiGraphicsPipeline ||
-                                res->mRhiShaderResourceBindings || res->mRhiSampler);
+            rhiObjectCreated = hasRhiObject(res);
         }
-        bool created = (res->mRhiTexture || res->mRhiBuffer || res->mRhiRenderBuffer || res->mRhiRenderTarget || res->
-                        mRhiGraphicsPipeline || res->mRhiShaderResourceBindings || res->mRhiSampler);
         if (rhiObjectCreated) {
             createdCount++;
         } else {
@@ -127,12 +221,314 @@ void RenderGraph::compile() {
         qCritical(
             "RenderGraph::compile - CRITICAL: %d required RHI resources could not be created. Rendering will likely fail or be incorrect.",
             failedCount);
-    } else {
-        qInfo() << "RenderGraph::compile finished successfully.";
-        mCompiled = true;
+        return false;
+    }
+    qInfo() << "RenderGraph::compile finished successfully.";
+    return true;
+}
+
+void RenderGraph::setupPasses() {
+    QVector<RGPass *> pending;
+    for (const auto &pass: std::as_const(mPasses)) {
+        if (pass) {
+            pending.append(pass.get());
+        } else {
+            qWarning("  Found null pass pointer during setup.");
+        }
+    }
+    // 每一轮至少有一个 pass 读到了所需资源才继续，否则剩下的读取没有任何 pass 写入
+    while (!pending.isEmpty()) {
+        QVector<RGPass *> deferred;
+        for (RGPass *pass: std::as_const(pending)) {
+            qInfo() << "    - Setting up pass:" << pass->name();
+            pass->mReads.clear();
+            pass->mWrites.clear();
+            pass->mUnresolvedReads.clear();
+            pass->mUsedResources.clear();
+            RGBuilder passBuilder(this, pass);
+            pass->setup(passBuilder);
+            if (!pass->mUnresolvedReads.isEmpty()) {
+                deferred.append(pass);
+            }
+        }
+        if (deferred.size() == pending.size()) {
+            for (RGPass *pass: std::as_const(deferred)) {
+                const QStringList missing(pass->mUnresolvedReads.cbegin(), pass->mUnresolvedReads.cend());
+                qWarning("  Pass '%s' reads resources that no pass writes: %s", qPrintable(pass->name()),
+                         qPrintable(missing.join(", ")));
+            }
+            break;
+        }
+        pending = std::move(deferred);
     }
 }
 
+void RenderGraph::cullPasses() {
+    const qint32 passCount = mPasses.size();
+    QHash<QString, QVector<qint32> > writers;
+    for (qint32 i = 0; i < passCount; ++i) {
+        if (!mPasses[i]) continue;
+        mPasses[i]->mCulled = true;
+        for (const QString &name: mPasses[i]->writes()) {
+            writers[name].append(i);
+        }
+    }
+
+    // 从写入屏幕或导出资源的 pass 出发，沿读取关系反向找出所有被用到的 pass
+    QVector<qint32> stack;
+    auto markLive = [this, &stack](qint32 index) {
+        if (mPasses[index]->mCulled) {
+            mPasses[index]->mCulled = false;
+            stack.append(index);
+        }
+    };
+    for (qint32 i = 0; i < passCount; ++i) {
+        if (!mPasses[i]) continue;
+        for (const QString &name: mPasses[i]->writes()) {
+            if (name == "SwapChainRenderTargetProxy" || mExportedResources.contains(name)) {
+                markLive(i);
+                break;
+            }
+        }
+    }
+    while (!stack.isEmpty()) {
+        const qint32 index = stack.takeLast();
+        for (const QString &name: mPasses[index]->reads()) {
+            const QVector<qint32> resourceWriters = writers.value(name);
+            const qint32 self = resourceWriters.indexOf(index);
+            const qint32 count = self >= 0 ? self : resourceWriters.size();
+            for (qint32 k = 0; k < count; ++k) {
+                markLive(resourceWriters[k]);
+            }
+        }
+    }
+
+    // 只被剔除的 pass 用到的资源不创建 RHI 对象，之前创建过的释放掉
+    QSet<QString> liveResources;
+    QSet<QString> culledPassResources;
+    for (const auto &pass: std::as_const(mPasses)) {
+        if (!pass) continue;
+        if (pass->mCulled) {
+            qInfo() << "    - Culled pass:" << pass->name();
+            culledPassResources.unite(pass->mUsedResources);
+        } else {
+            liveResources.unite(pass->mUsedResources);
+        }
+    }
+    mCulledResources = culledPassResources.subtract(liveResources);
+    for (const QString &name: std::as_const(mCulledResources)) {
+        if (RGResource *res = mResources.value(name).get()) {
+            releaseRhiResource(res);
+        }
+    }
+}
+
+bool RenderGraph::sortPasses() {
+    mExecutionOrder.clear();
+    const qint32 passCount = mPasses.size();
+
+    // 资源名 -> 按添加顺序排列的写入方
+    QHash<QString, QVector<qint32> > writers;
+    for (qint32 i = 0; i < passCount; ++i) {
+        if (!mPasses[i] || mPasses[i]->mCulled) continue;
+        for (const QString &name: mPasses[i]->writes()) {
+            writers[name].append(i);
+        }
+    }
+
+    QVector<QVector<qint32> > successors(passCount);
+    QVector<qint32> inDegree(passCount, 0);
+    auto addEdge = [&successors, &inDegree](qint32 from, qint32 to) {
+        successors[from].append(to);
+        ++inDegree[to];
+    };
+    // 同一资源的多个写入方按添加顺序串行
+    for (auto it = writers.cbegin(); it != writers.cend(); ++it) {
+        for (qint32 k = 1; k < it.value().size(); ++k) {
+            addEdge(it.value()[k - 1], it.value()[k]);
+        }
+    }
+    // 读取方排在写入方之后；既读又写的 pass 只依赖排在它前面的写入方
+    for (qint32 i = 0; i < passCount; ++i) {
+        if (!mPasses[i] || mPasses[i]->mCulled) continue;
+        for (const QString &name: mPasses[i]->reads()) {
+            const QVector<qint32> resourceWriters = writers.value(name);
+            const qint32 self = resourceWriters.indexOf(i);
+            const qint32 count = self >= 0 ? self : resourceWriters.size();
+            for (qint32 k = 0; k < count; ++k) {
+                addEdge(resourceWriters[k], i);
+            }
+        }
+    }
+
+    // Kahn 算法，就绪的 pass 中先取添加顺序靠前的，无依赖关系时保持添加顺序
+    std::priority_queue<qint32, std::vector<qint32>, std::greater<> > ready;
+    qint32 nodeCount = 0;
+    for (qint32 i = 0; i < passCount; ++i) {
+        if (!mPasses[i] || mPasses[i]->mCulled) continue;
+        ++nodeCount;
+        if (inDegree[i] == 0) ready.push(i);
+    }
+    mExecutionOrder.reserve(nodeCount);
+    while (!ready.empty()) {
+        const qint32 index = ready.top();
+        ready.pop();
+        mExecutionOrder.append(mPasses[index].get());
+        for (qint32 next: std::as_const(successors[index])) {
+            if (--inDegree[next] == 0) ready.push(next);
+        }
+    }
+
+    if (mExecutionOrder.size() != nodeCount) {
+        // 剩下入度不为零的 pass 在环上或依赖环上的 pass
+        QStringList blocked;
+        for (qint32 i = 0; i < passCount; ++i) {
+            if (mPasses[i] && !mPasses[i]->mCulled && inDegree[i] > 0) blocked.append(mPasses[i]->name());
+        }
+        qCritical("RenderGraph::compile - Dependency cycle between passes: %s. Compile aborted.",
+                  qPrintable(blocked.join(", ")));
+        mExecutionOrder.clear();
+        return false;
+    }
+    return true;
+}
+
+void RenderGraph::aliasTransientResources() {
+    struct Lifetime {
+        RGResource *resource;
+        qint32 first;
+        qint32 last;
+        bool transient;
+    };
+    // 按执行顺序记录每个纹理/渲染缓冲第一次和最后一次被使用的 pass 下标
+    QHash<QString, qint32> lifetimeIndex;
+    QVector<Lifetime> lifetimes;
+    for (qint32 k = 0; k < mExecutionOrder.size(); ++k) {
+        const RGPass *pass = mExecutionOrder[k];
+        for (const QString &name: pass->mUsedResources) {
+            RGResource *res = mResources.value(name).get();
+            if (!res || (res->type() != RGResource::Type::Texture && res->type() != RGResource::Type::RenderBuffer)) {
+                continue;
+            }
+            const auto found = lifetimeIndex.constFind(name);
+            if (found == lifetimeIndex.cend()) {
+                // 第一次使用就是写入的才是图内部产生的瞬态资源，导出的资源要在图外继续存在
+                const bool transient = pass->writes().contains(name) && !mExportedResources.contains(name);
+                lifetimeIndex.insert(name, lifetimes.size());
+                lifetimes.append({res, k, k, transient});
+            } else {
+                lifetimes[*found].last = k;
+            }
+        }
+    }
+    std::sort(lifetimes.begin(), lifetimes.end(), [](const Lifetime &a, const Lifetime &b) {
+        return a.first != b.first ? a.first < b.first : a.resource->name() < b.resource->name();
+    });
+
+    // 按首次使用顺序分配物理对象：找一个描述兼容且生命周期已经结束的，否则新开一个
+    struct PhysicalSlot {
+        RGResource *owner;
+        qint32 last;
+    };
+    QVector<PhysicalSlot> physicalSlots;
+    QHash<QString, QString> aliasOwners;
+    qint64 totalBytes = 0;
+    qint64 savedBytes = 0;
+    qint32 transientCount = 0;
+    for (const Lifetime &lifetime: std::as_const(lifetimes)) {
+        if (!lifetime.transient) continue;
+        ++transientCount;
+        const qint64 bytes = estimateBytes(lifetime.resource);
+        totalBytes += bytes;
+        auto slot = std::find_if(physicalSlots.begin(), physicalSlots.end(),
+                                 [&lifetime](const PhysicalSlot &candidate) {
+                                     return candidate.last < lifetime.first &&
+                                            canAlias(candidate.owner, lifetime.resource);
+                                 });
+        if (slot != physicalSlots.end()) {
+            aliasOwners.insert(lifetime.resource->name(), slot->owner->name());
+            slot->last = lifetime.last;
+            savedBytes += bytes;
+        } else {
+            physicalSlots.append({lifetime.resource, lifetime.last});
+        }
+    }
+
+    // 别名关系变化的资源丢掉旧的 RHI 对象，挂着它们的 render target 和使用这些 render target 的管线一起重建
+    QSet<QString> changed;
+    for (auto it = mAliasOwners.cbegin(); it != mAliasOwners.cend(); ++it) {
+        if (aliasOwners.value(it.key()) != it.value()) changed.insert(it.key());
+    }
+    for (auto it = aliasOwners.cbegin(); it != aliasOwners.cend(); ++it) {
+        if (mAliasOwners.value(it.key()) != it.value()) changed.insert(it.key());
+    }
+    mAliasOwners = std::move(aliasOwners);
+    if (!changed.isEmpty()) {
+        QSet<QString> rebuiltTargets;
+        for (const QString &name: std::as_const(changed)) {
+            if (RGResource *res = mResources.value(name).get()) {
+                res->mRhiTexture.reset();
+                res->mRhiRenderBuffer.reset();
+            }
+        }
+        for (auto it = mResources.cbegin(); it != mResources.cend(); ++it) {
+            if (it.value()->type() != RGResource::Type::RenderTarget) continue;
+            const auto *target = static_cast<const RGRenderTarget *>(it.value().get());
+            if (target->isExternal()) continue;
+            bool affected = target->depthStencilAttachmentRef().isValid() &&
+                            changed.contains(target->depthStencilAttachmentRef().mResource->name());
+            for (const RGTextureRef &color: target->colorAttachmentRefs()) {
+                affected = affected || (color.isValid() && changed.contains(color.mResource->name()));
+            }
+            if (affected) {
+                releaseRhiResource(it.value().get());
+                rebuiltTargets.insert(it.key());
+            }
+        }
+        for (auto it = mResources.cbegin(); it != mResources.cend(); ++it) {
+            if (it.value()->type() != RGResource::Type::Pipeline) continue;
+            const RGRenderTargetRef target = static_cast<const RGPipeline *>(it.value().get())->renderTargetRef();
+            if (target.isValid() && rebuiltTargets.contains(target.mResource->name())) {
+                releaseRhiResource(it.value().get());
+            }
+        }
+    }
+
+    qInfo("  Transient resources: %d in %d physical allocations, aliasing saves %.2f MB of %.2f MB.",
+          transientCount, static_cast<int>(physicalSlots.size()), savedBytes / (1024.0 * 1024.0),
+          totalBytes / (1024.0 * 1024.0));
+}
+
+qint32 RenderGraph::releaseChangedResources() {
+    QHash<QString, size_t> hashes;
+    hashes.reserve(mResources.size());
+    qint32 changedCount = 0;
+    // 资源表的遍历顺序不固定，图哈希对各资源的哈希求和，与顺序无关
+    size_t resourceSum = 0;
+    for (auto it = mResources.cbegin(); it != mResources.cend(); ++it) {
+        if (mCulledResources.contains(it.key())) continue;
+        RGResource *res = it.value().get();
+        const size_t hash = res->descriptorHash();
+        hashes.insert(it.key(), hash);
+        resourceSum += qHashMulti(0, it.key(), hash);
+        const auto previous = mResourceHashes.constFind(it.key());
+        if (previous == mResourceHashes.cend() || *previous == hash) continue;
+        // 依赖资源的描述包含在哈希里，附件尺寸变化时 render target 和管线也会走到这里
+        ++changedCount;
+        if (hasRhiObject(res)) {
+            releaseRhiResource(res);
+        }
+    }
+    mResourceHashes = std::move(hashes);
+
+    size_t graphHash = resourceSum;
+    for (const RGPass *pass: std::as_const(mExecutionOrder)) {
+        graphHash = qHashMulti(graphHash, pass->name());
+    }
+    mGraphHash = graphHash;
+    return changedCount;
+}
+
 void RenderGraph::execute(QRhiSwapChain *swapChain) {
     if (!mCompiled) {
         qWarning("RenderGraph::execute called before successful compile(). Skipping execution.");
@@ -182,6 +578,19 @@ QSharedPointer<RGResource> RenderGraph::findResource(const QString &name) const
     return mResources.value(name, nullptr);
 }
 
+void RenderGraph::exportResource(const QString &name) {
+    if (!mExportedResources.contains(name)) {
+        mExportedResources.insert(name);
+        mCompiled = false;
+    }
+}
+
+void RenderGraph::unexportResource(const QString &name) {
+    if (mExportedResources.remove(name)) {
+        mCompiled = false;
+    }
+}
+
 bool RenderGraph::removeResource(const QString &name) {
     return mResources.remove(name) > 0;
 }
@@ -215,31 +624,36 @@ void RenderGraph::setCommandBuffer(QRhiCommandBuffer *cmdBuffer) {
 }
 
 void RenderGraph::setOutputSize(const QSize &size) {
-    if (mOutputSize != size) {
-        qInfo() << "RenderGraph output size changed from" << mOutputSize << "to" << size;
-        mOutputSize = size;
-        mCompiled = false;
+    if (mOutputSize == size) return;
+    qInfo() << "RenderGraph output size changed from" << mOutputSize << "to" << size;
+    mOutputSize = size;
 
-        // --- 更新资源 ---
-        for (auto it = mResources.begin(); it != mResources.end(); ++it) {
-            RGResource *res = it.value().get();
-            if (!res) continue;
-
-            if (auto texRes = dynamic_cast<RGTexture *>(res)) {
-                if (res->name() == "BaseColor") {
-                    if (texRes->size() != mOutputSize) {
-                        qInfo() << "  Updating size description for Texture:" << res->name();
-                    }
-                }
-            } else if (auto rbRes = dynamic_cast<RGRenderBuffer *>(res)) {
-                if (res->name() == "DepthStencil") {
-                    if (rbRes->size() != mOutputSize) {
-                        qInfo() << "  Updating size description for RenderBuffer:" << res->name();
-                    }
-                }
-            }
+    // 只有相对输出尺寸的纹理和渲染缓冲跟着变，pass 不需要重新 setup
+    qint32 resizedCount = 0;
+    for (auto it = mResources.cbegin(); it != mResources.cend(); ++it) {
+        RGResource *res = it.value().get();
+        if (res->type() == RGResource::Type::Texture) {
+            resizedCount += static_cast<RGTexture *>(res)->resizeToOutput(size) ? 1 : 0;
+        } else if (res->type() == RGResource::Type::RenderBuffer) {
+            resizedCount += static_cast<RGRenderBuffer *>(res)->resizeToOutput(size) ? 1 : 0;
         }
     }
+    if (resizedCount > 0) {
+        mResizePending = true;
+    }
+}
+
+void RenderGraph::applyOutputResize() {
+    mResizePending = false;
+    if (!mOutputSize.isValid() || mOutputSize.isEmpty()) return;
+    // 固定尺寸与相对尺寸的资源此前可能描述相同而共用对象，按新尺寸重新分配别名
+    aliasTransientResources();
+    // 尺寸变化的资源描述哈希随之变化，引用它们的 render target 一并释放；管线只依赖附件格式，沿用原有对象
+    const qint32 changedCount = releaseChangedResources();
+    qInfo() << "RenderGraph: Applying output size" << mOutputSize << "-" << changedCount << "resources to rebuild.";
+    if (changedCount > 0) {
+        mCompiled = createRhiResources();
+    }
 }
 
 QRhiCommandBuffer *RenderGraph::getCommandBuffer() const {
@@ -290,7 +704,7 @@ void RenderGraph::createRhiResource(RGResource *resource) {
             qInfo() << "  --> Successfully created RHI object for:" << resource->name();
         }
     } else {
-        qInfo() << "  RHI object for resource '" << resource->name() << "' already exists and doesn't need rebuild.";
+        qDebug() << "  RHI object for resource '" << resource->name() << "' already exists and doesn't need rebuild.";
     }
 }
 
@@ -166,19 +166,19 @@ void ResourceManager::loadMaterial(const QString &materialId, const MaterialComp
     RhiMaterialGpuData gpuData;
     gpuData.albedoId = definition->albedoMapResourceId.isEmpty()
                            ? DEFAULT_WHITE_TEXTURE_ID
-                           : definition->albedoMapResourceId;
+                           : definition->albedoMapResourceId.toString();
     gpuData.normalId = definition->normalMapResourceId.isEmpty()
                            ? DEFAULT_NORMAL_MAP_ID
-                           : definition->normalMapResourceId;
+                           : definition->normalMapResourceId.toString();
     gpuData.metallicRoughnessId = definition->metallicRoughnessMapResourceId.isEmpty()
                                       ? DEFAULT_METALROUGH_TEXTURE_ID
-                                      : definition->metallicRoughnessMapResourceId;
+                                      : definition->metallicRoughnessMapResourceId.toString();
     gpuData.aoId = definition->ambientOcclusionMapResourceId.isEmpty()
                        ? DEFAULT_WHITE_TEXTURE_ID
-                       : definition->ambientOcclusionMapResourceId;
+                       : definition->ambientOcclusionMapResourceId.toString();
     gpuData.emissiveId = definition->emissiveMapResourceId.isEmpty()
                              ? DEFAULT_BLACK_TEXTURE_ID
-                             : definition->emissiveMapResourceId;
+                             : definition->emissiveMapResourceId.toString();
 
     qInfo() << "Loading material" << materialId << "with textures:"
             << gpuData.albedoId << gpuData.normalId << gpuData.metallicRoughnessId << gpuData.aoId << gpuData.
@@ -0,0 +1,94 @@
+#include "Scene/Archetype.h"
+
+namespace {
+    qsizetype alignUp(qsizetype value, qsizetype alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+Archetype::Archetype(QVector<const ComponentTypeInfo *> types)
+    : mTypes(std::move(types)) {
+    mSignature.reserve(mTypes.size());
+    if (!mTypes.isEmpty()) {
+        mColumnByType.fill(-1, static_cast<qsizetype>(mTypes.last()->id) + 1);
+    }
+    for (qint32 i = 0; i < mTypes.size(); ++i) {
+        mSignature.append(mTypes[i]->id);
+        mColumnByType[mTypes[i]->id] = i;
+    }
+
+    qsizetype rowBytes = sizeof(EntityID);
+    for (const ComponentTypeInfo *type: std::as_const(mTypes)) {
+        rowBytes += type->size + sizeof(quint32);
+    }
+
+    // 先按无对齐估算容量，再逐步减小直到加上对齐填充后放得下
+    auto layoutBytes = [this](qint32 capacity) {
+        qsizetype offset = static_cast<qsizetype>(capacity) * sizeof(EntityID);
+        mColumnOffsets.resize(mTypes.size());
+        for (qint32 i = 0; i < mTypes.size(); ++i) {
+            offset = alignUp(offset, mTypes[i]->alignment);
+            mColumnOffsets[i] = offset;
+            offset += static_cast<qsizetype>(capacity) * mTypes[i]->size;
+        }
+        mTickOffsets.resize(mTypes.size());
+        for (qint32 i = 0; i < mTypes.size(); ++i) {
+            offset = alignUp(offset, alignof(quint32));
+            mTickOffsets[i] = offset;
+            offset += static_cast<qsizetype>(capacity) * sizeof(quint32);
+        }
+        return offset;
+    };
+
+    mChunkCapacity = qMax<qint32>(1, static_cast<qint32>(ChunkBytes / rowBytes));
+    while (mChunkCapacity > 1 && layoutBytes(mChunkCapacity) > ChunkBytes) {
+        --mChunkCapacity;
+    }
+    // 单行就超过 ChunkBytes 的超大组件，退化为一行一个 chunk
+    mChunkBytes = qMax<qsizetype>(ChunkBytes, layoutBytes(mChunkCapacity));
+}
+
+Archetype::Location Archetype::allocateRow(EntityID entity) {
+    if (mChunks.empty() || mChunks.back().count == mChunkCapacity) {
+        ArchetypeChunk chunk;
+        chunk.memory.reset(static_cast<std::byte *>(::operator new(mChunkBytes, std::align_val_t{64})));
+        mChunks.push_back(std::move(chunk));
+    }
+
+    const qint32 chunkIndex = chunkCount() - 1;
+    ArchetypeChunk &chunk = mChunks.back();
+    const Location location{chunkIndex, chunk.count};
+    entities(chunkIndex)[chunk.count] = entity;
+    ++chunk.count;
+    ++mEntityCount;
+    return location;
+}
+
+void Archetype::destroyRow(const Location &location) {
+    for (qint32 column = 0; column < mTypes.size(); ++column) {
+        if (mTypes[column]->trivial) continue;
+        mTypes[column]->destroy(component(location, column));
+    }
+}
+
+EntityID Archetype::releaseRow(const Location &location) {
+    const qint32 lastChunk = chunkCount() - 1;
+    const Location last{lastChunk, mChunks.back().count - 1};
+
+    EntityID moved = INVALID_ENTITY;
+    if (location.chunk != last.chunk || location.row != last.row) {
+        for (qint32 column = 0; column < mTypes.size(); ++column) {
+            relocate(*mTypes[column], component(location, column), component(last, column));
+            changeTick(location, column) = changeTick(last, column);
+        }
+        moved = entities(last.chunk)[last.row];
+        entities(location.chunk)[location.row] = moved;
+    }
+
+    --mChunks.back().count;
+    --mEntityCount;
+    if (mChunks.back().count == 0) {
+        mChunks.pop_back();
+    }
+    return moved;
+}
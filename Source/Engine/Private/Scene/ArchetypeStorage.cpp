@@ -0,0 +1,153 @@
+#include "Scene/ArchetypeStorage.h"
+
+ArchetypeStorage::~ArchetypeStorage() {
+    for (const auto &archetype: mArchetypes) {
+        for (qint32 chunk = 0; chunk < archetype->chunkCount(); ++chunk) {
+            for (qint32 row = 0; row < archetype->chunkSize(chunk); ++row) {
+                archetype->destroyRow({chunk, row});
+            }
+        }
+    }
+}
+
+void ArchetypeStorage::remove(EntityID entity, ComponentTypeID typeId) {
+    if (!findRecord(entity)) return;
+    EntityRecord &entityRecord = record(entity);
+    Archetype *source = entityRecord.archetype;
+    if (!source) return;
+    const qint32 column = source->columnIndex(typeId);
+    if (column < 0) return;
+
+    source->types()[column]->destroy(source->component(entityRecord.location, column));
+    if (source->types().size() == 1) {
+        if (const EntityID moved = source->releaseRow(entityRecord.location); moved != INVALID_ENTITY) {
+            mRecords[entityIndex(moved)].location = entityRecord.location;
+        }
+        entityRecord = {};
+        return;
+    }
+    moveEntity(entity, entityRecord, archetypeWithout(source, typeId));
+}
+
+void ArchetypeStorage::removeEntity(EntityID entity) {
+    if (!findRecord(entity)) return;
+    EntityRecord &entityRecord = record(entity);
+    if (!entityRecord.archetype) return;
+
+    entityRecord.archetype->destroyRow(entityRecord.location);
+    if (const EntityID moved = entityRecord.archetype->releaseRow(entityRecord.location); moved != INVALID_ENTITY) {
+        mRecords[entityIndex(moved)].location = entityRecord.location;
+    }
+    entityRecord = {};
+}
+
+void ArchetypeStorage::cloneEntity(EntityID source, const QVector<EntityID> &targets, quint32 changeTick) {
+    const EntityRecord *sourceRecord = findRecord(source);
+    if (!sourceRecord || !sourceRecord->archetype) return;
+    // 先拷贝记录，reserveRecords 扩容会使指向 mRecords 的指针失效
+    Archetype *archetype = sourceRecord->archetype;
+    const Archetype::Location sourceLocation = sourceRecord->location;
+    reserveRecords(targets);
+
+    const QVector<const ComponentTypeInfo *> &types = archetype->types();
+    for (const EntityID entity: targets) {
+        const Archetype::Location location = archetype->allocateRow(entity);
+        mRecords[entityIndex(entity)] = {archetype, location};
+        for (qint32 column = 0; column < types.size(); ++column) {
+            void *dst = archetype->component(location, column);
+            const void *src = archetype->component(sourceLocation, column);
+            if (types[column]->trivial) {
+                std::memcpy(dst, src, types[column]->size);
+            } else {
+                types[column]->copyConstruct(dst, src);
+            }
+            archetype->changeTick(location, column) = changeTick;
+        }
+    }
+}
+
+void ArchetypeStorage::collectChangedSince(ComponentTypeID typeId, quint32 sinceTick, QVector<EntityID> &out) const {
+    for (const auto &archetype: mArchetypes) {
+        const qint32 column = archetype->columnIndex(typeId);
+        if (column < 0) continue;
+        for (qint32 chunk = 0; chunk < archetype->chunkCount(); ++chunk) {
+            const quint32 *ticks = archetype->changeTicks(chunk, column);
+            const EntityID *entities = archetype->entities(chunk);
+            for (qint32 row = 0; row < archetype->chunkSize(chunk); ++row) {
+                if (ticks[row] > sinceTick) {
+                    out.append(entities[row]);
+                }
+            }
+        }
+    }
+}
+
+Archetype *ArchetypeStorage::findOrCreateArchetype(QVector<const ComponentTypeInfo *> types) {
+    std::sort(types.begin(), types.end(), [](const ComponentTypeInfo *a, const ComponentTypeInfo *b) {
+        return a->id < b->id;
+    });
+    // Archetype 数量很少且有跳转缓存，线性查找即可
+    for (const auto &archetype: mArchetypes) {
+        if (archetype->types() == types) {
+            return archetype.get();
+        }
+    }
+    mArchetypes.push_back(std::make_unique<Archetype>(std::move(types)));
+    return mArchetypes.back().get();
+}
+
+Archetype *ArchetypeStorage::archetypeWith(Archetype *source, const ComponentTypeInfo &added) {
+    if (source) {
+        if (Archetype *cached = source->mAddEdges.value(added.id, nullptr)) {
+            return cached;
+        }
+    }
+    QVector<const ComponentTypeInfo *> types = source ? source->types() : QVector<const ComponentTypeInfo *>{};
+    types.append(&added);
+    Archetype *target = findOrCreateArchetype(std::move(types));
+    if (source) {
+        source->mAddEdges.insert(added.id, target);
+        target->mRemoveEdges.insert(added.id, source);
+    }
+    return target;
+}
+
+Archetype *ArchetypeStorage::archetypeWithout(Archetype *source, ComponentTypeID removed) {
+    if (Archetype *cached = source->mRemoveEdges.value(removed, nullptr)) {
+        return cached;
+    }
+    QVector<const ComponentTypeInfo *> types;
+    for (const ComponentTypeInfo *type: source->types()) {
+        if (type->id != removed) {
+            types.append(type);
+        }
+    }
+    Archetype *target = findOrCreateArchetype(std::move(types));
+    source->mRemoveEdges.insert(removed, target);
+    target->mAddEdges.insert(removed, source);
+    return target;
+}
+
+Archetype::Location ArchetypeStorage::moveEntity(EntityID entity, EntityRecord &record, Archetype *target) {
+    const Archetype::Location location = target->allocateRow(entity);
+    Archetype *source = record.archetype;
+
+    if (source) {
+        // 两边共有的列逐个移动；source 独有的列（被删除的组件）调用方已经析构
+        for (qint32 column = 0; column < source->types().size(); ++column) {
+            const ComponentTypeInfo *type = source->types()[column];
+            const qint32 targetColumn = target->columnIndex(type->id);
+            if (targetColumn < 0) continue;
+            Archetype::relocate(*type, target->component(location, targetColumn),
+                                source->component(record.location, column));
+            target->changeTick(location, targetColumn) = source->changeTick(record.location, column);
+        }
+        if (const EntityID moved = source->releaseRow(record.location); moved != INVALID_ENTITY) {
+            mRecords[entityIndex(moved)].location = record.location;
+        }
+    }
+
+    record.archetype = target;
+    record.location = location;
+    return location;
+}
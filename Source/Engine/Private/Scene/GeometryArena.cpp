@@ -0,0 +1,47 @@
+#include "Scene/GeometryArena.h"
+
+#include <cstring>
+
+GeometryArena *GeometryArena::getInstance() {
+    static GeometryArena instance;
+    return &instance;
+}
+
+GeometryHandle GeometryArena::allocate(const QVector<VertexData> &vertices, const QVector<quint16> &indices) {
+    if (vertices.isEmpty()) return {};
+    const size_t vertexBytes = vertices.size() * sizeof(VertexData);
+    const size_t indexBytes = indices.size() * sizeof(quint16);
+    const size_t hash = qHashBits(indices.constData(), indexBytes, qHashBits(vertices.constData(), vertexBytes));
+
+    QMutexLocker locker(&mMutex);
+    for (auto it = mIdsByContent.constFind(hash); it != mIdsByContent.cend() && it.key() == hash; ++it) {
+        const Range &range = mRanges[it.value() - 1];
+        if (range.vertexCount == vertices.size() && range.indexCount == indices.size()
+            && std::memcmp(mVertices.constData() + range.firstVertex, vertices.constData(), vertexBytes) == 0
+            && (indexBytes == 0
+                || std::memcmp(mIndices.constData() + range.firstIndex, indices.constData(), indexBytes) == 0)) {
+            return GeometryHandle{it.value()};
+        }
+    }
+
+    mRanges.append(Range{mVertices.size(), vertices.size(), mIndices.size(), indices.size()});
+    mVertices.append(vertices);
+    mIndices.append(indices);
+    const quint32 id = static_cast<quint32>(mRanges.size());
+    mIdsByContent.insert(hash, id);
+    return GeometryHandle{id};
+}
+
+QVector<VertexData> GeometryArena::vertices(GeometryHandle handle) const {
+    QMutexLocker locker(&mMutex);
+    if (!handle.isValid() || handle.id > static_cast<quint32>(mRanges.size())) return {};
+    const Range &range = mRanges[handle.id - 1];
+    return mVertices.mid(range.firstVertex, range.vertexCount);
+}
+
+QVector<quint16> GeometryArena::indices(GeometryHandle handle) const {
+    QMutexLocker locker(&mMutex);
+    if (!handle.isValid() || handle.id > static_cast<quint32>(mRanges.size())) return {};
+    const Range &range = mRanges[handle.id - 1];
+    return mIndices.mid(range.firstIndex, range.indexCount);
+}
@@ -0,0 +1,130 @@
+#include "Scene/JobSystem.h"
+
+#include <atomic>
+#include <memory>
+#include <QSemaphore>
+#include <QThread>
+
+namespace {
+    /*!
+     * 一个工作线程拥有的块区间 [begin, end)，打包进一个 64 位原子量
+     * 拥有者从头部取块，窃取者从尾部取块，双方都通过 CAS 修改，无需加锁
+     */
+    class ChunkRange {
+    public:
+        void reset(quint32 begin, quint32 end) { mPacked.store(pack(begin, end), std::memory_order_relaxed); }
+
+        bool popFront(quint32 &chunk) {
+            quint64 packed = mPacked.load(std::memory_order_acquire);
+            while (true) {
+                const quint32 begin = unpackBegin(packed);
+                const quint32 end = unpackEnd(packed);
+                if (begin >= end) return false;
+                if (mPacked.compare_exchange_weak(packed, pack(begin + 1, end), std::memory_order_acq_rel)) {
+                    chunk = begin;
+                    return true;
+                }
+            }
+        }
+
+        bool stealBack(quint32 &chunk) {
+            quint64 packed = mPacked.load(std::memory_order_acquire);
+            while (true) {
+                const quint32 begin = unpackBegin(packed);
+                const quint32 end = unpackEnd(packed);
+                if (begin >= end) return false;
+                if (mPacked.compare_exchange_weak(packed, pack(begin, end - 1), std::memory_order_acq_rel)) {
+                    chunk = end - 1;
+                    return true;
+                }
+            }
+        }
+
+    private:
+        static quint64 pack(quint32 begin, quint32 end) { return (static_cast<quint64>(end) << 32) | begin; }
+        static quint32 unpackBegin(quint64 packed) { return static_cast<quint32>(packed & 0xFFFFFFFFull); }
+        static quint32 unpackEnd(quint64 packed) { return static_cast<quint32>(packed >> 32); }
+
+        // 按缓存行对齐，避免不同线程的区间伪共享
+        alignas(64) std::atomic<quint64> mPacked{0};
+    };
+
+    struct ParallelForState {
+        std::unique_ptr<ChunkRange[]> ranges;
+        qint32 workerCount = 0;
+        qint32 count = 0;
+        qint32 grainSize = 1;
+        const std::function<void(qint32, qint32)> *fn = nullptr;
+
+        void runChunk(quint32 chunk) const {
+            const qint32 begin = static_cast<qint32>(chunk) * grainSize;
+            (*fn)(begin, qMin(begin + grainSize, count));
+        }
+
+        // 先做完自己的分段，再轮流窃取其他分段，直到全部为空
+        void work(qint32 self) const {
+            quint32 chunk;
+            while (ranges[self].popFront(chunk)) {
+                runChunk(chunk);
+            }
+            for (qint32 offset = 1; offset < workerCount; ++offset) {
+                ChunkRange &victim = ranges[(self + offset) % workerCount];
+                while (victim.stealBack(chunk)) {
+                    runChunk(chunk);
+                }
+            }
+        }
+    };
+}
+
+JobSystem *JobSystem::getInstance() {
+    static JobSystem instance;
+    return &instance;
+}
+
+JobSystem::JobSystem() {
+    mPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+JobSystem::~JobSystem() {
+    mPool.waitForDone();
+}
+
+void JobSystem::parallelFor(qint32 count, qint32 grainSize, const std::function<void(qint32, qint32)> &fn) {
+    if (count <= 0) return;
+    grainSize = qMax(1, grainSize);
+    const qint32 chunkCount = (count + grainSize - 1) / grainSize;
+    if (chunkCount == 1) {
+        fn(0, count);
+        return;
+    }
+
+    ParallelForState state;
+    state.workerCount = qMin(chunkCount, concurrency());
+    state.ranges = std::make_unique<ChunkRange[]>(state.workerCount);
+    state.count = count;
+    state.grainSize = grainSize;
+    state.fn = &fn;
+
+    // 块均匀地预先分给各个线程，保证每段内部是连续的内存
+    for (qint32 worker = 0; worker < state.workerCount; ++worker) {
+        const quint32 begin = static_cast<quint64>(chunkCount) * worker / state.workerCount;
+        const quint32 end = static_cast<quint64>(chunkCount) * (worker + 1) / state.workerCount;
+        state.ranges[worker].reset(begin, end);
+    }
+
+    QSemaphore finished;
+    qint32 started = 0;
+    for (qint32 worker = 1; worker < state.workerCount; ++worker) {
+        const bool accepted = mPool.tryStart([&state, &finished, worker]() {
+            state.work(worker);
+            finished.release();
+        });
+        if (!accepted) break;
+        ++started;
+    }
+
+    // 没能启动的线程的分段由调用线程窃取完成
+    state.work(0);
+    finished.acquire(started);
+}
@@ -0,0 +1,271 @@
+#include "Scene/RenderScene.h"
+
+#include <cstring>
+
+#include "Component/CameraComponent.h"
+#include "Component/LightComponent.h"
+#include "Component/MeshComponent.h"
+#include "Component/RenderableComponent.h"
+#include "Component/SingletonComponents.h"
+#include "Component/TagComponents.h"
+#include "Component/TransformComponent.h"
+#include "Component/WorldTransformComponent.h"
+#include "Scene/World.h"
+
+RenderScene::RenderScene(QSharedPointer<World> world): mWorld(std::move(world)) {
+    if (!mWorld) return;
+    // 增删只有观察者能看到（删除不留下变更 tick），修改由 publish 按 tick 收集
+    auto markDirty = [this](World &, EntityID entity) { mStructureDirty.insert(entity); };
+    mObserverIds = {
+        mWorld->onAdd<RenderableComponent>(markDirty),
+        mWorld->onRemove<RenderableComponent>(markDirty),
+        mWorld->onAdd<MeshComponent>(markDirty),
+        mWorld->onRemove<MeshComponent>(markDirty),
+        mWorld->onAdd<MaterialComponent>(markDirty),
+        mWorld->onRemove<MaterialComponent>(markDirty),
+        mWorld->onAdd<TransformComponent>(markDirty),
+        mWorld->onRemove<TransformComponent>(markDirty)
+    };
+    for (EntityID entity: mWorld->group<RenderableComponent, MeshComponent, MaterialComponent, TransformComponent>()) {
+        mStructureDirty.insert(entity);
+    }
+    mPendingChanges.reset = true;
+}
+
+RenderScene::~RenderScene() {
+    if (!mWorld) return;
+    for (const quint32 id: std::as_const(mObserverIds)) {
+        mWorld->removeObserver(id);
+    }
+}
+
+void RenderScene::publish() {
+    if (!mWorld) return;
+    const quint32 since = mLastTick;
+    mLastTick = mWorld->advanceChangeTick();
+
+    QSet<EntityID> drawDirty = std::move(mStructureDirty);
+    mStructureDirty.clear();
+    for (EntityID entity: mWorld->changedSince<RenderableComponent>(since)) {
+        drawDirty.insert(entity);
+    }
+    for (EntityID entity: mWorld->changedSince<MeshComponent>(since)) {
+        drawDirty.insert(entity);
+    }
+    for (EntityID entity: mWorld->changedSince<MaterialComponent>(since)) {
+        drawDirty.insert(entity);
+    }
+    // 层级中的实体看 TransformSystem 写回的世界矩阵，没有世界矩阵缓存的实体看本地 Transform
+    QVector<EntityID> transformDirty = mWorld->changedSince<WorldTransformComponent>(since);
+    for (EntityID entity: mWorld->changedSince<TransformComponent>(since)) {
+        if (!mWorld->hasComponent<WorldTransformComponent>(entity)) {
+            transformDirty.append(entity);
+        }
+    }
+
+    // 后台帧上一次被写是在两次发布之前，要补上上一次和本次的变化
+    RenderSceneFrame &back = mFrames[1 - mFrontIndex];
+    for (EntityID entity: std::as_const(mPreviousDrawDirty)) {
+        if (!drawDirty.contains(entity)) {
+            syncInstance(back, entity);
+        }
+    }
+    for (EntityID entity: std::as_const(drawDirty)) {
+        syncInstance(back, entity);
+    }
+    for (EntityID entity: std::as_const(mPreviousTransformDirty)) {
+        syncTransform(back, entity);
+    }
+    for (EntityID entity: std::as_const(transformDirty)) {
+        syncTransform(back, entity);
+    }
+    syncCameraAndLights(back);
+
+    {
+        QMutexLocker locker(&mFrameMutex);
+        mFrontIndex = 1 - mFrontIndex;
+        if (!mPendingChanges.reset) {
+            for (EntityID entity: std::as_const(drawDirty)) {
+                if (!mPendingDrawSet.contains(entity)) {
+                    mPendingDrawSet.insert(entity);
+                    mPendingChanges.drawChanged.append(entity);
+                }
+            }
+            for (EntityID entity: std::as_const(transformDirty)) {
+                if (!mPendingTransformSet.contains(entity)) {
+                    mPendingTransformSet.insert(entity);
+                    mPendingChanges.transformChanged.append(entity);
+                }
+            }
+            // 渲染端长时间没有读取时，累积的变化多于实例总数，不如让它全量重建
+            const qsizetype pending = mPendingChanges.drawChanged.size() + mPendingChanges.transformChanged.size();
+            if (pending > back.instances.size() + 1024) {
+                mPendingChanges = RenderSceneChanges{true, {}, {}};
+                mPendingDrawSet.clear();
+                mPendingTransformSet.clear();
+            }
+        }
+    }
+    mPreviousDrawDirty = std::move(drawDirty);
+    mPreviousTransformDirty = std::move(transformDirty);
+}
+
+const RenderSceneFrame &RenderScene::acquireFrame(RenderSceneChanges &changes) {
+    mFrameMutex.lock();
+    changes = std::move(mPendingChanges);
+    mPendingChanges = RenderSceneChanges{};
+    mPendingDrawSet.clear();
+    mPendingTransformSet.clear();
+    return mFrames[mFrontIndex];
+}
+
+void RenderScene::releaseFrame() {
+    mFrameMutex.unlock();
+}
+
+void RenderScene::syncInstance(RenderSceneFrame &frame, EntityID entity) {
+    const auto *renderable = mWorld->getComponent<RenderableComponent>(entity);
+    const auto *meshComp = mWorld->getComponent<MeshComponent>(entity);
+    const auto *matComp = mWorld->getComponent<MaterialComponent>(entity);
+    const auto *tfComp = mWorld->getComponent<TransformComponent>(entity);
+    if (!renderable || !renderable->isVisible || !meshComp || meshComp->meshResourceId.isEmpty()
+        || !matComp || !tfComp) {
+        if (meshComp && meshComp->meshResourceId.isEmpty()) {
+            qWarning("Entity %lld has MeshComponent but no meshResourceId set.", entity);
+        }
+        removeInstance(frame, entity);
+        return;
+    }
+
+    qint32 index = frame.instanceIndexByEntity.value(entity, -1);
+    if (index < 0) {
+        index = static_cast<qint32>(frame.instances.size());
+        frame.instances.append(RenderInstanceProxy{});
+        frame.instances.last().entity = entity;
+        frame.instanceIndexByEntity.insert(entity, index);
+    }
+    RenderInstanceProxy &proxy = frame.instances[index];
+    proxy.meshId = meshComp->meshResourceId;
+    proxy.material = *matComp;
+    syncTransform(frame, entity);
+}
+
+void RenderScene::syncTransform(RenderSceneFrame &frame, EntityID entity) {
+    const qint32 index = frame.instanceIndexByEntity.value(entity, -1);
+    if (index < 0) return;
+    RenderInstanceProxy &proxy = frame.instances[index];
+    // 法线矩阵按 mat4 上传，第 4 行/列保持单位矩阵
+    if (const auto *worldTransform = mWorld->getComponent<WorldTransformComponent>(entity)) {
+        proxy.instance.model = worldTransform->worldMatrix.toGenericMatrix<4, 4>();
+        proxy.normal.normalMatrix = QMatrix4x4(worldTransform->normalMatrix).toGenericMatrix<4, 4>();
+    } else if (const auto *tfComp = mWorld->getComponent<TransformComponent>(entity)) {
+        const QMatrix4x4 model = tfComp->localMatrix();
+        proxy.instance.model = model.toGenericMatrix<4, 4>();
+        proxy.normal.normalMatrix = QMatrix4x4(model.normalMatrix()).toGenericMatrix<4, 4>();
+    }
+}
+
+void RenderScene::removeInstance(RenderSceneFrame &frame, EntityID entity) {
+    const qint32 index = frame.instanceIndexByEntity.value(entity, -1);
+    if (index < 0) return;
+    frame.instanceIndexByEntity.remove(entity);
+    // 与末尾交换删除，实例顺序由渲染端的分桶决定
+    const qint32 last = static_cast<qint32>(frame.instances.size()) - 1;
+    if (index != last) {
+        frame.instances[index] = std::move(frame.instances[last]);
+        frame.instanceIndexByEntity[frame.instances[index].entity] = index;
+    }
+    frame.instances.removeLast();
+}
+
+void RenderScene::syncCameraAndLights(RenderSceneFrame &frame) {
+    // 相机和灯光数量很少，每次发布整体重写
+    const auto *activeCamera = mWorld->singleton<ActiveCameraSingleton>();
+    if (!mWorld->hasComponent<CameraComponent>(mActiveCamera) ||
+        (activeCamera && activeCamera->camera != mActiveCamera &&
+         mWorld->hasComponent<CameraComponent>(activeCamera->camera))) {
+        findActiveCamera();
+    }
+    frame.camera = RenderCameraProxy{};
+    const auto *camComp = mWorld->getComponent<CameraComponent>(mActiveCamera);
+    const auto *camTf = mWorld->getComponent<TransformComponent>(mActiveCamera);
+    if (camComp && camTf) {
+        frame.camera.entity = mActiveCamera;
+        frame.camera.position = camTf->position();
+        frame.camera.forward = camTf->forward();
+        frame.camera.up = camTf->up();
+        frame.camera.fov = camComp->mFov;
+        frame.camera.nearPlane = camComp->mNearPlane;
+        frame.camera.farPlane = camComp->mFarPlane;
+    }
+
+    LightingUniformBlock &lightData = frame.lighting;
+    memset(&lightData, 0, sizeof(LightingUniformBlock));
+    int pointLightCount = 0;
+    bool dirLightSet = false;
+
+    // 主方向光由单例直接给出，下面的循环只需收集点光源
+    if (const auto *mainLight = mWorld->singleton<MainDirectionalLightSingleton>()) {
+        const auto *lightComp = mWorld->getComponent<LightComponent>(mainLight->light);
+        const auto *lightTf = mWorld->getComponent<TransformComponent>(mainLight->light);
+        if (lightComp && lightTf && lightComp->type == LightType::Directional) {
+            lightData.dirLight.direction = lightTf->rotation().rotatedVector({0, 0, -1}).normalized();
+            lightData.dirLight.color = lightComp->color * lightComp->intensity;
+            lightData.dirLight.enabled = 1;
+            dirLightSet = true;
+        }
+    }
+    const bool dirLightFromSingleton = dirLightSet;
+
+    for (EntityID entity: mWorld->group<LightComponent, TransformComponent>()) {
+        const auto *lightComp = mWorld->getComponent<LightComponent>(entity);
+        const auto *lightTf = mWorld->getComponent<TransformComponent>(entity);
+        if (!lightComp || !lightTf) continue;
+
+        switch (lightComp->type) {
+            case LightType::Directional:
+                if (dirLightFromSingleton || dirLightSet) break;
+                lightData.dirLight.direction = lightTf->rotation().rotatedVector({0, 0, -1}).normalized();
+                lightData.dirLight.color = lightComp->color * lightComp->intensity;
+                lightData.dirLight.enabled = 1;
+                dirLightSet = true;
+                break;
+            case LightType::Point:
+                if (pointLightCount < MAX_POINT_LIGHTS) {
+                    auto &pl = lightData.pointLights[pointLightCount];
+                    pl.position = lightTf->position();
+                    pl.color = lightComp->color * lightComp->intensity;
+                    pl.constant = lightComp->constantAttenuation;
+                    pl.linear = lightComp->linearAttenuation;
+                    pl.quadratic = lightComp->quadraticAttenuation;
+                    pointLightCount++;
+                }
+                break;
+        }
+    }
+    lightData.numPointLights = pointLightCount;
+}
+
+void RenderScene::findActiveCamera() {
+    mActiveCamera = INVALID_ENTITY;
+    if (const auto *activeCamera = mWorld->singleton<ActiveCameraSingleton>();
+        activeCamera && mWorld->hasComponent<CameraComponent>(activeCamera->camera) &&
+        mWorld->hasComponent<TransformComponent>(activeCamera->camera)) {
+        mActiveCamera = activeCamera->camera;
+    }
+    if (mActiveCamera == INVALID_ENTITY) {
+        const QVector<EntityID> &tagged = mWorld->group<CameraComponent, TransformComponent, ActiveCameraTag>();
+        if (!tagged.isEmpty()) {
+            mActiveCamera = tagged.constFirst();
+        }
+    }
+    if (mActiveCamera == INVALID_ENTITY) {
+        const QVector<EntityID> &cameras = mWorld->group<CameraComponent, TransformComponent>();
+        if (!cameras.isEmpty()) {
+            mActiveCamera = cameras.constFirst();
+        }
+    }
+    if (mActiveCamera != INVALID_ENTITY) {
+        qInfo() << "RenderScene: Found active camera entity:" << mActiveCamera;
+    }
+}
@@ -0,0 +1,152 @@
+#include "Scene/SpatialHashGrid.h"
+
+#include <cmath>
+
+namespace {
+    constexpr qint32 CellCoordBits = 21;
+    constexpr qint32 CellCoordLimit = 1 << (CellCoordBits - 1);
+}
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+    : mCellSize(cellSize > 0.0f ? cellSize : 1.0f), mInvCellSize(1.0f / mCellSize) {
+}
+
+void SpatialHashGrid::clear() {
+    mCells.clear();
+    mSlots.clear();
+    mCount = 0;
+}
+
+void SpatialHashGrid::insertOrUpdate(EntityID entity, const QVector3D &position) {
+    const quint32 index = entityIndex(entity);
+    if (index >= static_cast<quint32>(mSlots.size())) {
+        mSlots.resize(index + 1);
+    }
+    Slot &slot = mSlots[index];
+    // 同一下标上还留着已销毁的旧实体，先移除
+    if (slot.index >= 0 && slot.entity != entity) {
+        removeFromCell(slot);
+        slot = Slot{};
+        --mCount;
+    }
+
+    const CellKey cell = cellKeyOf(position);
+    if (slot.index >= 0) {
+        if (slot.cell == cell) {
+            mCells[cell][slot.index].position = position;
+            return;
+        }
+        removeFromCell(slot);
+    } else {
+        ++mCount;
+    }
+    QVector<Entry> &entries = mCells[cell];
+    mSlots[index] = Slot{entity, cell, static_cast<qint32>(entries.size())};
+    entries.append(Entry{entity, position});
+}
+
+void SpatialHashGrid::remove(EntityID entity) {
+    if (!contains(entity)) return;
+    Slot &slot = mSlots[entityIndex(entity)];
+    removeFromCell(slot);
+    slot = Slot{};
+    --mCount;
+}
+
+bool SpatialHashGrid::contains(EntityID entity) const {
+    const quint32 index = entityIndex(entity);
+    return index < static_cast<quint32>(mSlots.size()) && mSlots[index].index >= 0 && mSlots[index].entity == entity;
+}
+
+void SpatialHashGrid::queryRadius(const QVector3D &center, float radius, QVector<EntityID> &out) const {
+    if (radius < 0.0f) return;
+    const QVector3D extent(radius, radius, radius);
+    const float radiusSquared = radius * radius;
+    queryCells(center - extent, center + extent, [&center, radiusSquared](const QVector3D &position) {
+        return (position - center).lengthSquared() <= radiusSquared;
+    }, out);
+}
+
+void SpatialHashGrid::queryAabb(const QVector3D &min, const QVector3D &max, QVector<EntityID> &out) const {
+    if (min.x() > max.x() || min.y() > max.y() || min.z() > max.z()) return;
+    queryCells(min, max, [&min, &max](const QVector3D &position) {
+        return position.x() >= min.x() && position.x() <= max.x() &&
+               position.y() >= min.y() && position.y() <= max.y() &&
+               position.z() >= min.z() && position.z() <= max.z();
+    }, out);
+}
+
+template<typename Predicate>
+void SpatialHashGrid::queryCells(const QVector3D &min, const QVector3D &max, Predicate &&inside,
+                                 QVector<EntityID> &out) const {
+    if (mCount == 0) return;
+    const qint32 minX = cellCoord(min.x());
+    const qint32 minY = cellCoord(min.y());
+    const qint32 minZ = cellCoord(min.z());
+    const qint32 maxX = cellCoord(max.x());
+    const qint32 maxY = cellCoord(max.y());
+    const qint32 maxZ = cellCoord(max.z());
+
+    auto collect = [&](const QVector<Entry> &entries) {
+        for (const Entry &entry: entries) {
+            if (inside(entry.position)) {
+                out.append(entry.entity);
+            }
+        }
+    };
+
+    // 查询范围覆盖的格子比非空格子还多时，直接遍历非空格子
+    const quint64 rangeCells = static_cast<quint64>(maxX - minX + 1) * static_cast<quint64>(maxY - minY + 1) *
+                               static_cast<quint64>(maxZ - minZ + 1);
+    if (rangeCells >= static_cast<quint64>(mCells.size())) {
+        for (const QVector<Entry> &entries: mCells) {
+            collect(entries);
+        }
+        return;
+    }
+    for (qint32 x = minX; x <= maxX; ++x) {
+        for (qint32 y = minY; y <= maxY; ++y) {
+            for (qint32 z = minZ; z <= maxZ; ++z) {
+                const auto it = mCells.constFind(packCell(x, y, z));
+                if (it != mCells.constEnd()) {
+                    collect(it.value());
+                }
+            }
+        }
+    }
+}
+
+qint32 SpatialHashGrid::cellCoord(float value) const {
+    const float cell = std::floor(value * mInvCellSize);
+    // NaN 和超出范围的坐标都夹到边界格子
+    if (!(cell > -CellCoordLimit)) return -CellCoordLimit;
+    if (cell > CellCoordLimit - 1) return CellCoordLimit - 1;
+    return static_cast<qint32>(cell);
+}
+
+SpatialHashGrid::CellKey SpatialHashGrid::cellKeyOf(const QVector3D &position) const {
+    return packCell(cellCoord(position.x()), cellCoord(position.y()), cellCoord(position.z()));
+}
+
+SpatialHashGrid::CellKey SpatialHashGrid::packCell(qint32 x, qint32 y, qint32 z) {
+    constexpr quint64 mask = (quint64(1) << CellCoordBits) - 1;
+    return (static_cast<quint64>(x + CellCoordLimit) & mask) << (2 * CellCoordBits) |
+           (static_cast<quint64>(y + CellCoordLimit) & mask) << CellCoordBits |
+           (static_cast<quint64>(z + CellCoordLimit) & mask);
+}
+
+void SpatialHashGrid::removeFromCell(const Slot &slot) {
+    auto it = mCells.find(slot.cell);
+    if (it == mCells.end()) return;
+    // 与格子末尾交换删除
+    QVector<Entry> &entries = it.value();
+    const Entry last = entries.last();
+    entries[slot.index] = last;
+    if (last.entity != slot.entity) {
+        mSlots[entityIndex(last.entity)].index = slot.index;
+    }
+    entries.removeLast();
+    if (entries.isEmpty()) {
+        mCells.erase(it);
+    }
+}
@@ -0,0 +1,43 @@
+#include "Scene/StringTable.h"
+
+StringTable *StringTable::getInstance() {
+    static StringTable instance;
+    return &instance;
+}
+
+StringTable::StringTable() {
+    intern(QString());
+}
+
+StringTable::~StringTable() {
+    for (auto &chunk: mChunks) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+quint32 StringTable::intern(const QString &value) {
+    QMutexLocker locker(&mMutex);
+    // 空字符串和 null 字符串都映射到 0
+    if (value.isEmpty() && mCount.load(std::memory_order_relaxed) > 0) return 0;
+    if (const auto it = mIdByString.constFind(value); it != mIdByString.constEnd()) {
+        return it.value();
+    }
+
+    const quint32 id = mCount.load(std::memory_order_relaxed);
+    const quint32 chunkIndex = id >> ChunkShift;
+    Q_ASSERT_X(chunkIndex < MaxChunks, "StringTable::intern", "too many interned strings");
+    QString *chunk = mChunks[chunkIndex].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new QString[ChunkSize];
+        mChunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+    chunk[id & (ChunkSize - 1)] = value;
+    mIdByString.insert(value, id);
+    mCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+const QString &StringTable::resolve(quint32 id) const {
+    Q_ASSERT_X(id < size(), "StringTable::resolve", "unknown string id");
+    return mChunks[id >> ChunkShift].load(std::memory_order_acquire)[id & (ChunkSize - 1)];
+}
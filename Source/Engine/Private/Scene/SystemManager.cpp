@@ -1,7 +1,99 @@
 #include "Scene/SystemManager.h"
 
+#include "Scene/World.h"
+#include "Scene/WorldCommandBuffer.h"
+
+#include <algorithm>
+#include <QSemaphore>
+#include <QThread>
+
+namespace {
+    bool intersects(const QVector<ComponentTypeID> &a, const QVector<ComponentTypeID> &b) {
+        return std::any_of(a.begin(), a.end(), [&b](const ComponentTypeID &id) { return b.contains(id); });
+    }
+}
+
+bool SystemAccess::conflictsWith(const SystemAccess &other) const {
+    if (exclusive || other.exclusive) return true;
+    return intersects(writes, other.writes) || intersects(writes, other.reads) || intersects(reads, other.writes);
+}
+
+SystemManager::SystemManager() {
+    mThreadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+void SystemManager::buildSchedule() {
+    mWaves.clear();
+
+    QVector<SystemAccess> accesses;
+    QVector<qint32> levels;
+    accesses.reserve(mSystems.size());
+    levels.reserve(mSystems.size());
+
+    // 系统 i 依赖所有先注册且与之冲突的系统 j，层级 = 依赖的最大层级 + 1
+    for (qint32 i = 0; i < mSystems.size(); ++i) {
+        accesses.append(mSystems[i]->access());
+        qint32 level = 0;
+        for (qint32 j = 0; j < i; ++j) {
+            if (accesses[i].conflictsWith(accesses[j])) {
+                level = qMax(level, levels[j] + 1);
+            }
+        }
+        levels.append(level);
+        if (level >= mWaves.size()) {
+            mWaves.resize(level + 1);
+        }
+        mWaves[level].append(mSystems[i].get());
+    }
+
+    mScheduleDirty = false;
+    mWarmedUp = false;
+}
+
 void SystemManager::updateAll(World *world, float deltaTime) {
-    for (auto& system : mSystems) {
-        system->update(world, deltaTime);
+    if (mScheduleDirty) {
+        buildSchedule();
+    }
+
+    // 帧开始前先应用其他线程（例如后台导入）在两帧之间录制的结构变化
+    WorldCommandBuffer &commands = world->commands();
+    commands.playback(*world);
+
+    if (!mWarmedUp) {
+        for (auto &system: mSystems) {
+            system->update(world, deltaTime);
+            commands.playback(*world);
+        }
+        mWarmedUp = true;
+        return;
+    }
+
+    for (const QVector<ISystem *> &wave: std::as_const(mWaves)) {
+        if (wave.size() == 1) {
+            wave.first()->update(world, deltaTime);
+            commands.playback(*world);
+            continue;
+        }
+
+        QVector<ISystem *> inlineSystems;
+        QSemaphore finished;
+        qint32 pooledCount = 0;
+        for (ISystem *system: wave) {
+            if (system->access().mainThread) {
+                inlineSystems.append(system);
+                continue;
+            }
+            ++pooledCount;
+            mThreadPool.start([system, world, deltaTime, &finished]() {
+                system->update(world, deltaTime);
+                finished.release();
+            });
+        }
+        for (ISystem *system: std::as_const(inlineSystems)) {
+            system->update(world, deltaTime);
+        }
+        finished.acquire(pooledCount);
+        // 批次之间是同步点：本批系统录制的结构变化在下一批开始前生效
+        commands.playback(*world);
     }
 }
@@ -0,0 +1,270 @@
+#include "Scene/TransformSoA.h"
+
+#include <cstring>
+
+#include "Component/TransformComponent.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define QTR_TRANSFORM_AVX2
+#define QTR_TRANSFORM_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define QTR_TRANSFORM_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QTR_TRANSFORM_NEON
+#endif
+
+namespace {
+    struct TransformStreams {
+        const float *positionX;
+        const float *positionY;
+        const float *positionZ;
+        const float *rotationX;
+        const float *rotationY;
+        const float *rotationZ;
+        const float *rotationW;
+        const float *scaleX;
+        const float *scaleY;
+        const float *scaleZ;
+    };
+
+    // 每个通道一个矩阵，columns[列][行]
+    template<typename V>
+    struct MatrixLanes {
+        V columns[4][4];
+    };
+
+    /*!
+     * 各指令集共用的合成公式，V 的每个通道独立计算一个 T * R * S
+     * 旋转部分与 QMatrix4x4::rotate(QQuaternion) 展开的结果一致，缩放乘到对应的列上
+     */
+    template<typename V>
+    MatrixLanes<V> composeLanes(const TransformStreams &s, qint32 i) {
+        const V x = V::load(s.rotationX + i);
+        const V y = V::load(s.rotationY + i);
+        const V z = V::load(s.rotationZ + i);
+        const V w = V::load(s.rotationW + i);
+        const V sx = V::load(s.scaleX + i);
+        const V sy = V::load(s.scaleY + i);
+        const V sz = V::load(s.scaleZ + i);
+        const V zero = V::splat(0.0f);
+        const V one = V::splat(1.0f);
+
+        const V x2 = x + x;
+        const V y2 = y + y;
+        const V z2 = z + z;
+        const V xx = x * x2;
+        const V yy = y * y2;
+        const V zz = z * z2;
+        const V xy = x * y2;
+        const V xz = x * z2;
+        const V yz = y * z2;
+        const V wx = w * x2;
+        const V wy = w * y2;
+        const V wz = w * z2;
+
+        return {
+            {
+                {(one - yy - zz) * sx, (xy + wz) * sx, (xz - wy) * sx, zero},
+                {(xy - wz) * sy, (one - xx - zz) * sy, (yz + wx) * sy, zero},
+                {(xz + wy) * sz, (yz - wx) * sz, (one - xx - yy) * sz, zero},
+                {V::load(s.positionX + i), V::load(s.positionY + i), V::load(s.positionZ + i), one}
+            }
+        };
+    }
+
+    struct ScalarLane {
+        float v;
+
+        static ScalarLane load(const float *p) { return {*p}; }
+        static ScalarLane splat(float f) { return {f}; }
+
+        friend ScalarLane operator+(ScalarLane a, ScalarLane b) { return {a.v + b.v}; }
+        friend ScalarLane operator-(ScalarLane a, ScalarLane b) { return {a.v - b.v}; }
+        friend ScalarLane operator*(ScalarLane a, ScalarLane b) { return {a.v * b.v}; }
+    };
+
+    void storeLanes(const MatrixLanes<ScalarLane> &m, char *out, qsizetype) {
+        float matrix[16];
+        for (qint32 c = 0; c < 4; ++c) {
+            for (qint32 r = 0; r < 4; ++r) {
+                matrix[c * 4 + r] = m.columns[c][r].v;
+            }
+        }
+        std::memcpy(out, matrix, sizeof(matrix));
+    }
+
+#ifdef QTR_TRANSFORM_SSE2
+    struct SseLane {
+        __m128 v;
+
+        static SseLane load(const float *p) { return {_mm_loadu_ps(p)}; }
+        static SseLane splat(float f) { return {_mm_set1_ps(f)}; }
+
+        friend SseLane operator+(SseLane a, SseLane b) { return {_mm_add_ps(a.v, b.v)}; }
+        friend SseLane operator-(SseLane a, SseLane b) { return {_mm_sub_ps(a.v, b.v)}; }
+        friend SseLane operator*(SseLane a, SseLane b) { return {_mm_mul_ps(a.v, b.v)}; }
+    };
+
+    // 每一列的 4 个分量向量转置成 4 个矩阵各自的一列
+    void storeLanes(const MatrixLanes<SseLane> &m, char *out, qsizetype stride) {
+        for (qint32 c = 0; c < 4; ++c) {
+            __m128 r0 = m.columns[c][0].v;
+            __m128 r1 = m.columns[c][1].v;
+            __m128 r2 = m.columns[c][2].v;
+            __m128 r3 = m.columns[c][3].v;
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            char *column = out + c * 4 * sizeof(float);
+            _mm_storeu_ps(reinterpret_cast<float *>(column), r0);
+            _mm_storeu_ps(reinterpret_cast<float *>(column + stride), r1);
+            _mm_storeu_ps(reinterpret_cast<float *>(column + 2 * stride), r2);
+            _mm_storeu_ps(reinterpret_cast<float *>(column + 3 * stride), r3);
+        }
+    }
+#endif
+
+#ifdef QTR_TRANSFORM_AVX2
+    struct AvxLane {
+        __m256 v;
+
+        static AvxLane load(const float *p) { return {_mm256_loadu_ps(p)}; }
+        static AvxLane splat(float f) { return {_mm256_set1_ps(f)}; }
+
+        friend AvxLane operator+(AvxLane a, AvxLane b) { return {_mm256_add_ps(a.v, b.v)}; }
+        friend AvxLane operator-(AvxLane a, AvxLane b) { return {_mm256_sub_ps(a.v, b.v)}; }
+        friend AvxLane operator*(AvxLane a, AvxLane b) { return {_mm256_mul_ps(a.v, b.v)}; }
+    };
+
+    // 8 个通道拆成高低两半，各按 SSE 的 4x4 转置写出
+    void storeLanes(const MatrixLanes<AvxLane> &m, char *out, qsizetype stride) {
+        MatrixLanes<SseLane> low;
+        MatrixLanes<SseLane> high;
+        for (qint32 c = 0; c < 4; ++c) {
+            for (qint32 r = 0; r < 4; ++r) {
+                low.columns[c][r].v = _mm256_castps256_ps128(m.columns[c][r].v);
+                high.columns[c][r].v = _mm256_extractf128_ps(m.columns[c][r].v, 1);
+            }
+        }
+        storeLanes(low, out, stride);
+        storeLanes(high, out + 4 * stride, stride);
+    }
+#endif
+
+#ifdef QTR_TRANSFORM_NEON
+    struct NeonLane {
+        float32x4_t v;
+
+        static NeonLane load(const float *p) { return {vld1q_f32(p)}; }
+        static NeonLane splat(float f) { return {vdupq_n_f32(f)}; }
+
+        friend NeonLane operator+(NeonLane a, NeonLane b) { return {vaddq_f32(a.v, b.v)}; }
+        friend NeonLane operator-(NeonLane a, NeonLane b) { return {vsubq_f32(a.v, b.v)}; }
+        friend NeonLane operator*(NeonLane a, NeonLane b) { return {vmulq_f32(a.v, b.v)}; }
+    };
+
+    void storeLanes(const MatrixLanes<NeonLane> &m, char *out, qsizetype stride) {
+        for (qint32 c = 0; c < 4; ++c) {
+            const float32x4x2_t t01 = vtrnq_f32(m.columns[c][0].v, m.columns[c][1].v);
+            const float32x4x2_t t23 = vtrnq_f32(m.columns[c][2].v, m.columns[c][3].v);
+            char *column = out + c * 4 * sizeof(float);
+            vst1q_f32(reinterpret_cast<float *>(column),
+                      vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+            vst1q_f32(reinterpret_cast<float *>(column + stride),
+                      vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+            vst1q_f32(reinterpret_cast<float *>(column + 2 * stride),
+                      vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+            vst1q_f32(reinterpret_cast<float *>(column + 3 * stride),
+                      vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+        }
+    }
+#endif
+}
+
+void TransformSoA::clear() {
+    for (QVector<float> *stream: {&mPositionX, &mPositionY, &mPositionZ, &mRotationX, &mRotationY, &mRotationZ,
+                                  &mRotationW, &mScaleX, &mScaleY, &mScaleZ}) {
+        stream->clear();
+    }
+}
+
+void TransformSoA::reserve(qint32 count) {
+    for (QVector<float> *stream: {&mPositionX, &mPositionY, &mPositionZ, &mRotationX, &mRotationY, &mRotationZ,
+                                  &mRotationW, &mScaleX, &mScaleY, &mScaleZ}) {
+        stream->reserve(count);
+    }
+}
+
+void TransformSoA::append(const TransformComponent &transform) {
+    const QVector3D position = transform.position();
+    const QQuaternion rotation = transform.rotation();
+    const QVector3D scale = transform.scale();
+    mPositionX.append(position.x());
+    mPositionY.append(position.y());
+    mPositionZ.append(position.z());
+    mRotationX.append(rotation.x());
+    mRotationY.append(rotation.y());
+    mRotationZ.append(rotation.z());
+    mRotationW.append(rotation.scalar());
+    mScaleX.append(scale.x());
+    mScaleY.append(scale.y());
+    mScaleZ.append(scale.z());
+}
+
+void TransformSoA::set(qint32 index, const TransformComponent &transform) {
+    const QVector3D position = transform.position();
+    const QQuaternion rotation = transform.rotation();
+    const QVector3D scale = transform.scale();
+    mPositionX[index] = position.x();
+    mPositionY[index] = position.y();
+    mPositionZ[index] = position.z();
+    mRotationX[index] = rotation.x();
+    mRotationY[index] = rotation.y();
+    mRotationZ[index] = rotation.z();
+    mRotationW[index] = rotation.scalar();
+    mScaleX[index] = scale.x();
+    mScaleY[index] = scale.y();
+    mScaleZ[index] = scale.z();
+}
+
+void TransformSoA::composeMatrices(qint32 begin, qint32 end, void *output, qsizetype stride) const {
+    Q_ASSERT(begin >= 0 && end <= size());
+    const TransformStreams streams{
+        mPositionX.constData(), mPositionY.constData(), mPositionZ.constData(),
+        mRotationX.constData(), mRotationY.constData(), mRotationZ.constData(), mRotationW.constData(),
+        mScaleX.constData(), mScaleY.constData(), mScaleZ.constData()
+    };
+    char *out = static_cast<char *>(output);
+    qint32 i = begin;
+#ifdef QTR_TRANSFORM_AVX2
+    for (; i + 8 <= end; i += 8, out += 8 * stride) {
+        storeLanes(composeLanes<AvxLane>(streams, i), out, stride);
+    }
+#endif
+#if defined(QTR_TRANSFORM_SSE2)
+    for (; i + 4 <= end; i += 4, out += 4 * stride) {
+        storeLanes(composeLanes<SseLane>(streams, i), out, stride);
+    }
+#elif defined(QTR_TRANSFORM_NEON)
+    for (; i + 4 <= end; i += 4, out += 4 * stride) {
+        storeLanes(composeLanes<NeonLane>(streams, i), out, stride);
+    }
+#endif
+    // 不足一组的尾部逐个处理
+    for (; i < end; ++i, out += stride) {
+        storeLanes(composeLanes<ScalarLane>(streams, i), out, stride);
+    }
+}
+
+const char *TransformSoA::kernelName() {
+#if defined(QTR_TRANSFORM_AVX2)
+    return "avx2";
+#elif defined(QTR_TRANSFORM_SSE2)
+    return "sse2";
+#elif defined(QTR_TRANSFORM_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
@@ -1 +1,193 @@
 #include "Scene/World.h"
+
+#include "Scene/WorldCommandBuffer.h"
+
+World::World(StorageMode mode) : mCommandBuffer(std::make_unique<WorldCommandBuffer>()), mStorageMode(mode) {
+}
+
+World::~World() = default;
+
+QVector<EntityID> World::instantiate(EntityID prefab, qint32 count) {
+    if (!isAlive(prefab) || count <= 0) return {};
+    // 拷贝一份类型列表，allocateEntities 扩容会使指向槽位的引用失效
+    const QVector<ComponentTypeID> types = mEntitySlots[entityIndex(prefab)].componentTypes;
+    const QVector<EntityID> entities = allocateEntities(count, types);
+    const quint32 tick = changeTick();
+    if (mStorageMode == StorageMode::Archetype) {
+        mArchetypeStorage.cloneEntity(prefab, entities, tick);
+    } else {
+        for (const ComponentTypeID &typeId: types) {
+            mComponentArrays[typeId]->cloneEntity(prefab, entities, tick);
+        }
+    }
+    onEntitiesCreated(entities, types, tick);
+    return entities;
+}
+
+void World::clear() {
+    for (quint32 index = 1; index < static_cast<quint32>(mEntitySlots.size()); ++index) {
+        if (mEntitySlots[index].alive) {
+            destroyEntity(makeEntity(index, mEntitySlots[index].generation));
+        }
+    }
+    // 单例通常引用场景中的实体，随实体一起失效
+    for (ComponentTypeID typeId = 0; typeId < static_cast<ComponentTypeID>(mSingletons.size()); ++typeId) {
+        if (mSingletons[typeId]) {
+            mSingletons[typeId].reset();
+            markTypeChanged(typeId, changeTick());
+        }
+    }
+}
+
+QVector<EntityID> World::allocateEntities(qint32 count, const QVector<ComponentTypeID> &types) {
+    QVector<EntityID> entities;
+    entities.reserve(count);
+    const qint32 reused = qMin<qint32>(count, mFreeIndices.size());
+    for (qint32 i = 0; i < reused; ++i) {
+        const quint32 index = mFreeIndices.takeLast();
+        EntitySlot &slot = mEntitySlots[index];
+        slot.alive = true;
+        slot.componentTypes = types;
+        entities.append(makeEntity(index, slot.generation));
+    }
+
+    const quint32 firstNew = static_cast<quint32>(mEntitySlots.size());
+    mEntitySlots.resize(mEntitySlots.size() + (count - reused));
+    for (quint32 index = firstNew; index < static_cast<quint32>(mEntitySlots.size()); ++index) {
+        EntitySlot &slot = mEntitySlots[index];
+        slot.alive = true;
+        slot.componentTypes = types;
+        entities.append(makeEntity(index, slot.generation));
+    }
+    return entities;
+}
+
+void World::onEntitiesCreated(const QVector<EntityID> &entities, const QVector<ComponentTypeID> &types, quint32 tick) {
+    for (const auto &group: mGroups) {
+        const bool matches = std::all_of(group->required.begin(), group->required.end(),
+                                         [&types](const ComponentTypeID &typeId) { return types.contains(typeId); });
+        if (!matches) continue;
+        group->members.reserve(group->members.size() + entities.size());
+        for (const EntityID entity: entities) {
+            group->members.insert(entity);
+        }
+    }
+
+    for (const ComponentTypeID &typeId: types) {
+        markTypeChanged(typeId, tick);
+    }
+    if (!types.isEmpty()) {
+        mStructureChangeTick = tick;
+    }
+
+    for (const ComponentTypeID &typeId: types) {
+        if (!hasObservers(ObserverKind::Add, typeId)) continue;
+        for (const EntityID entity: entities) {
+            notifyObservers(ObserverKind::Add, typeId, entity);
+        }
+    }
+}
+
+void World::collectChangedSince(ComponentTypeID typeId, quint32 sinceTick, QVector<EntityID> &out) const {
+    if (mStorageMode == StorageMode::Archetype) {
+        mArchetypeStorage.collectChangedSince(typeId, sinceTick, out);
+    } else if (const auto array = mComponentArrays.value(typeId)) {
+        array->collectChangedSince(sinceTick, out);
+    }
+}
+
+World::ObserverID World::addObserver(ObserverKind kind, ComponentTypeID typeId, ComponentObserver callback) {
+    if (typeId >= static_cast<ComponentTypeID>(mObservers.size())) {
+        mObservers.resize(typeId + 1);
+    }
+    TypeObservers &observers = mObservers[typeId];
+    if (kind == ObserverKind::Change && observers.lists[kind].isEmpty()) {
+        // 注册之前的写入不派发
+        observers.lastChangeDispatch = advanceChangeTick();
+    }
+    const ObserverID id = mNextObserverID++;
+    observers.lists[kind].append({id, std::move(callback)});
+    return id;
+}
+
+void World::removeObserver(ObserverID id) {
+    for (TypeObservers &observers: mObservers) {
+        for (QVector<Observer> &list: observers.lists) {
+            list.removeIf([id](const Observer &observer) { return observer.id == id; });
+        }
+    }
+}
+
+void World::notifyObservers(ObserverKind kind, ComponentTypeID typeId, EntityID entity) {
+    // 先拷贝列表（隐式共享，只是引用计数），回调里增删观察者不影响本次遍历
+    const QVector<Observer> observers = mObservers[typeId].lists[kind];
+    for (const Observer &observer: observers) {
+        observer.callback(*this, entity);
+    }
+}
+
+void World::dispatchChangeObservers() {
+    const quint32 tick = advanceChangeTick();
+    for (ComponentTypeID typeId = 0; typeId < static_cast<ComponentTypeID>(mObservers.size()); ++typeId) {
+        if (!hasObservers(ObserverKind::Change, typeId)) continue;
+        const quint32 since = mObservers[typeId].lastChangeDispatch;
+        mObservers[typeId].lastChangeDispatch = tick;
+        if (typeChangeTick(typeId) <= since) continue;
+
+        QVector<EntityID> changed;
+        collectChangedSince(typeId, since, changed);
+        for (const EntityID entity: std::as_const(changed)) {
+            // 前面的回调可能销毁了实体
+            if (isAlive(entity)) {
+                notifyObservers(ObserverKind::Change, typeId, entity);
+            }
+        }
+    }
+}
+
+World::EntityGroup *World::findOrCreateGroup(QVector<ComponentTypeID> required) {
+    std::sort(required.begin(), required.end());
+    required.erase(std::unique(required.begin(), required.end()), required.end());
+    for (const auto &group: mGroups) {
+        if (group->required == required) {
+            return group.get();
+        }
+    }
+
+    auto group = std::make_unique<EntityGroup>();
+    group->required = std::move(required);
+    for (const ComponentTypeID &typeId: std::as_const(group->required)) {
+        if (typeId >= static_cast<ComponentTypeID>(mGroupsByType.size())) {
+            mGroupsByType.resize(typeId + 1);
+        }
+        mGroupsByType[typeId].append(group.get());
+    }
+    mGroups.push_back(std::move(group));
+    return mGroups.back().get();
+}
+
+bool World::entityMatches(EntityID entity, const QVector<ComponentTypeID> &required) const {
+    if (!isAlive(entity)) return false;
+    const QVector<ComponentTypeID> &types = mEntitySlots[entityIndex(entity)].componentTypes;
+    return std::all_of(required.begin(), required.end(), [&types](const ComponentTypeID &typeId) {
+        return types.contains(typeId);
+    });
+}
+
+void World::addToGroups(EntityID entity, ComponentTypeID addedType) {
+    if (addedType >= static_cast<ComponentTypeID>(mGroupsByType.size())) return;
+    for (EntityGroup *group: std::as_const(mGroupsByType[addedType])) {
+        if (!group->members.contains(entity) && entityMatches(entity, group->required)) {
+            group->members.insert(entity);
+        }
+    }
+}
+
+void World::removeFromGroups(EntityID entity, const QVector<ComponentTypeID> &removedTypes) {
+    for (const ComponentTypeID &typeId: removedTypes) {
+        if (typeId >= static_cast<ComponentTypeID>(mGroupsByType.size())) continue;
+        for (EntityGroup *group: std::as_const(mGroupsByType[typeId])) {
+            group->members.remove(entity);
+        }
+    }
+}
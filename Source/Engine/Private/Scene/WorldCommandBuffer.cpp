@@ -0,0 +1,115 @@
+#include "Scene/WorldCommandBuffer.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+    std::atomic<quint64> sNextBufferId{1};
+
+    struct CachedRecorder {
+        quint64 bufferId;
+        void *recorder;
+    };
+}
+
+WorldCommandBuffer::WorldCommandBuffer() : mBufferId(sNextBufferId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+WorldCommandBuffer::~WorldCommandBuffer() = default;
+
+EntityID WorldCommandBuffer::createEntity() {
+    quint32 pendingIndex = mNextPendingIndex.fetch_add(1, std::memory_order_relaxed) + 1;
+    // 下标 0 留给无效句柄，回绕时跳过
+    if (pendingIndex == 0) {
+        pendingIndex = mNextPendingIndex.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    const EntityID pending = makeEntity(pendingIndex, PENDING_ENTITY_GENERATION);
+    // 创建也作为一条命令录制，回放时与引用它的命令在同一批次里被取走
+    record(pending, nullptr);
+    return pending;
+}
+
+void WorldCommandBuffer::destroyEntity(EntityID entity) {
+    record(entity, [](World &world, EntityID target) {
+        world.destroyEntity(target);
+    });
+}
+
+void WorldCommandBuffer::record(EntityID entity, std::function<void(World &, EntityID)> apply) {
+    Recorder &recorder = localRecorder();
+    QMutexLocker locker(&recorder.mutex);
+    recorder.commands.append({entity, std::move(apply)});
+}
+
+WorldCommandBuffer::Recorder &WorldCommandBuffer::localRecorder() {
+    // 线程池线程会长期存活，缓存本线程在各个命令缓冲区中的录制器，只有第一次注册需要加锁
+    thread_local QVector<CachedRecorder> cache;
+    for (const CachedRecorder &cached: std::as_const(cache)) {
+        if (cached.bufferId == mBufferId) {
+            return *static_cast<Recorder *>(cached.recorder);
+        }
+    }
+
+    QMutexLocker locker(&mRecordersMutex);
+    mRecorders.push_back(std::make_unique<Recorder>());
+    Recorder *recorder = mRecorders.back().get();
+    cache.append({mBufferId, recorder});
+    return *recorder;
+}
+
+bool WorldCommandBuffer::isEmpty() const {
+    if (!mDeferred.isEmpty()) return false;
+    QMutexLocker locker(&mRecordersMutex);
+    return std::all_of(mRecorders.begin(), mRecorders.end(), [](const std::unique_ptr<Recorder> &recorder) {
+        QMutexLocker recorderLocker(&recorder->mutex);
+        return recorder->commands.isEmpty();
+    });
+}
+
+void WorldCommandBuffer::playback(World &world) {
+    // 逐个录制器取走命令；回放中的命令（例如组件观察者）和其他线程可能继续录制，新命令留到下一次回放
+    QVector<QVector<Command> > batches;
+    batches.append(std::exchange(mDeferred, {}));
+    {
+        QMutexLocker locker(&mRecordersMutex);
+        batches.reserve(static_cast<qsizetype>(mRecorders.size()) + 1);
+        for (const std::unique_ptr<Recorder> &recorder: mRecorders) {
+            QMutexLocker recorderLocker(&recorder->mutex);
+            batches.append(std::exchange(recorder->commands, {}));
+        }
+    }
+
+    // 先创建本批次取到的全部待定实体，后续命令可以跨录制器引用它们
+    QHash<quint32, EntityID> created;
+    for (const QVector<Command> &commands: std::as_const(batches)) {
+        for (const Command &command: commands) {
+            if (!command.apply) {
+                created.insert(entityIndex(command.entity), world.createEntity());
+            }
+        }
+    }
+
+    for (qsizetype batch = 0; batch < batches.size(); ++batch) {
+        for (Command &command: batches[batch]) {
+            if (!command.apply) continue;
+            EntityID target = command.entity;
+            if (isPendingEntity(target)) {
+                const quint32 pendingIndex = entityIndex(target);
+                if (created.contains(pendingIndex)) {
+                    target = created.value(pendingIndex);
+                } else if (mPreviousCreated.contains(pendingIndex)) {
+                    target = mPreviousCreated.value(pendingIndex);
+                } else if (batch != 0) {
+                    // 创建命令在取走之后才录制，留到下一次回放
+                    mDeferred.append(std::move(command));
+                    continue;
+                } else {
+                    // 已经推迟过一次仍找不到创建命令，句柄无效
+                    target = INVALID_ENTITY;
+                }
+            }
+            command.apply(world, target);
+        }
+    }
+    mPreviousCreated = std::move(created);
+}
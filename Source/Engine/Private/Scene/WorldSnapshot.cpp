@@ -0,0 +1,355 @@
+#include "Scene/WorldSnapshot.h"
+
+#include <QFile>
+#include <QSet>
+
+#include "Component/CameraComponent.h"
+#include "Component/CameraControllerComponent.h"
+#include "Component/HierarchyComponent.h"
+#include "Component/LightComponent.h"
+#include "Component/MaterialComponent.h"
+#include "Component/MeshComponent.h"
+#include "Component/RenderableComponent.h"
+#include "Component/TagComponents.h"
+#include "Component/TransformComponent.h"
+
+namespace {
+    constexpr quint32 SnapshotMagic = 0x53525451; // "QTRS"
+    // 2：网格顶点移入几何体表
+    constexpr quint32 SnapshotVersion = 2;
+}
+
+void SnapshotWriter::writeString(const QString &value) {
+    auto it = mStringIndices.find(value);
+    if (it == mStringIndices.end()) {
+        it = mStringIndices.insert(value, static_cast<quint32>(mStrings.size()));
+        mStrings.append(value);
+    }
+    write<quint32>(it.value());
+}
+
+void SnapshotWriter::writeGeometry(GeometryHandle handle) {
+    if (!handle.isValid()) {
+        write<quint32>(0);
+        return;
+    }
+    auto it = mGeometryIndices.find(handle.id);
+    if (it == mGeometryIndices.end()) {
+        mGeometries.append(handle);
+        it = mGeometryIndices.insert(handle.id, static_cast<quint32>(mGeometries.size()));
+    }
+    write<quint32>(it.value());
+}
+
+bool SnapshotReader::readRaw(void *dst, qsizetype bytes) {
+    if (!mOk || bytes < 0 || bytes > remaining()) {
+        mOk = false;
+        return false;
+    }
+    if (bytes > 0) {
+        std::memcpy(dst, mData.constData() + mPosition, bytes);
+    }
+    mPosition += bytes;
+    return true;
+}
+
+bool SnapshotReader::skip(qsizetype bytes) {
+    if (!mOk || bytes < 0 || bytes > remaining()) {
+        mOk = false;
+        return false;
+    }
+    mPosition += bytes;
+    return true;
+}
+
+QString SnapshotReader::readString() {
+    const quint32 index = read<quint32>();
+    if (!mOk || index >= static_cast<quint32>(mStrings.size())) {
+        mOk = false;
+        return {};
+    }
+    return mStrings[index];
+}
+
+GeometryHandle SnapshotReader::readGeometry() {
+    const quint32 index = read<quint32>();
+    if (!mOk || index > static_cast<quint32>(mGeometries.size())) {
+        mOk = false;
+        return {};
+    }
+    return index == 0 ? GeometryHandle{} : mGeometries[index - 1];
+}
+
+WorldSnapshot *WorldSnapshot::getInstance() {
+    static WorldSnapshot instance;
+    return &instance;
+}
+
+WorldSnapshot::WorldSnapshot() {
+    registerComponent<TransformComponent>("Transform");
+    registerComponent<LightComponent>("Light");
+    registerComponent<CameraComponent>("Camera");
+    registerComponent<CameraControllerComponent>("CameraController");
+    registerComponent<RenderableComponent>("Renderable");
+    // 句柄按原样恢复，父节点引用读回后仍然有效；WorldTransform 由 TransformSystem 重新计算，不写入快照
+    registerComponent<HierarchyComponent>("Hierarchy");
+    // 单例不属于实体，不写入快照；读回后 BasePass 按 ActiveCameraTag 重新选取相机
+    registerComponent<ActiveCameraTag>("ActiveCameraTag");
+
+    registerComponent<MaterialComponent>(
+        "Material",
+        [](SnapshotWriter &writer, const MaterialComponent &material) {
+            writer.write(material.albedoFactor);
+            writer.write(material.metallicFactor);
+            writer.write(material.roughnessFactor);
+            writer.write(material.emissiveFactor);
+            writer.write(material.aoStrength);
+            writer.writeString(material.albedoMapResourceId);
+            writer.writeString(material.specularMapResourceId);
+            writer.writeString(material.normalMapResourceId);
+            writer.writeString(material.metallicRoughnessMapResourceId);
+            writer.writeString(material.ambientOcclusionMapResourceId);
+            writer.writeString(material.emissiveMapResourceId);
+        },
+        [](SnapshotReader &reader, MaterialComponent &material) {
+            material.albedoFactor = reader.read<QVector3D>();
+            material.metallicFactor = reader.read<float>();
+            material.roughnessFactor = reader.read<float>();
+            material.emissiveFactor = reader.read<QVector3D>();
+            material.aoStrength = reader.read<float>();
+            material.albedoMapResourceId = reader.readString();
+            material.specularMapResourceId = reader.readString();
+            material.normalMapResourceId = reader.readString();
+            material.metallicRoughnessMapResourceId = reader.readString();
+            material.ambientOcclusionMapResourceId = reader.readString();
+            material.emissiveMapResourceId = reader.readString();
+        });
+
+    registerComponent<MeshComponent>(
+        "Mesh",
+        [](SnapshotWriter &writer, const MeshComponent &mesh) {
+            writer.writeGeometry(mesh.geometry);
+            writer.writeString(mesh.meshResourceId);
+        },
+        [](SnapshotReader &reader, MeshComponent &mesh) {
+            mesh.geometry = reader.readGeometry();
+            mesh.meshResourceId = reader.readString();
+            // 读回的顶点还没有上传过
+            mesh.rhiDataDirty = true;
+        });
+}
+
+void WorldSnapshot::addSerializer(ComponentSerializer serializer) {
+    Q_ASSERT_X(!mSerializerByName.contains(serializer.name), "WorldSnapshot::registerComponent",
+               "component name registered twice");
+    mSerializerByName.insert(serializer.name, mSerializers.size());
+    mSerializers.append(std::move(serializer));
+}
+
+QByteArray WorldSnapshot::save(const World &world) const {
+    SnapshotWriter writer;
+
+    // --- 实体槽位 ---
+    QVector<quint32> generations(world.mEntitySlots.size());
+    QVector<quint32> aliveIndices;
+    aliveIndices.reserve(world.entityCount());
+    for (qint32 index = 0; index < world.mEntitySlots.size(); ++index) {
+        generations[index] = world.mEntitySlots[index].generation;
+        if (world.mEntitySlots[index].alive) {
+            aliveIndices.append(static_cast<quint32>(index));
+        }
+    }
+    writer.writeArray(generations);
+    writer.writeArray(aliveIndices);
+
+    // --- 组件块 ---
+    const qsizetype blockCountOffset = writer.position();
+    writer.write<quint32>(0);
+    quint32 blockCount = 0;
+    for (const ComponentSerializer &serializer: mSerializers) {
+        const qsizetype blockStart = writer.position();
+        writer.writeString(serializer.name);
+        writer.write<quint32>(serializer.elementSize);
+        if (serializer.save(world, writer)) {
+            ++blockCount;
+        } else {
+            // 回退块头，类型名留在字符串表里无害
+            writer.rollback(blockStart);
+        }
+    }
+    writer.patch<quint32>(blockCountOffset, blockCount);
+
+    // 字符串表要等组件全部写完才完整，放在 body 之前
+    QByteArray result;
+    const auto appendValue = [&result](quint32 value) {
+        result.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    appendValue(SnapshotMagic);
+    appendValue(SnapshotVersion);
+    appendValue(static_cast<quint32>(writer.strings().size()));
+    for (const QString &string: writer.strings()) {
+        const QByteArray utf8 = string.toUtf8();
+        appendValue(static_cast<quint32>(utf8.size()));
+        result.append(utf8);
+    }
+    // 几何体表同理，每个被引用的句柄一份顶点和索引
+    SnapshotWriter geometryWriter;
+    const GeometryArena *arena = GeometryArena::getInstance();
+    geometryWriter.write<quint32>(static_cast<quint32>(writer.geometries().size()));
+    for (const GeometryHandle handle: writer.geometries()) {
+        geometryWriter.writeArray(arena->vertices(handle));
+        geometryWriter.writeArray(arena->indices(handle));
+    }
+    result.append(geometryWriter.body());
+    result.append(writer.body());
+    return result;
+}
+
+bool WorldSnapshot::load(World &world, const QByteArray &data) const {
+    SnapshotReader reader(data);
+    if (reader.read<quint32>() != SnapshotMagic || reader.read<quint32>() != SnapshotVersion) {
+        qWarning() << "WorldSnapshot::load - not a snapshot or unsupported version";
+        return false;
+    }
+
+    const quint32 stringCount = reader.read<quint32>();
+    if (!reader.ok() || stringCount > static_cast<quint32>(reader.remaining() / sizeof(quint32))) {
+        qWarning() << "WorldSnapshot::load - corrupted string table";
+        return false;
+    }
+    QVector<QString> strings;
+    strings.reserve(stringCount);
+    for (quint32 i = 0; i < stringCount && reader.ok(); ++i) {
+        const quint32 length = reader.read<quint32>();
+        if (!reader.ok() || length > static_cast<quint32>(reader.remaining())) {
+            reader.fail();
+            break;
+        }
+        strings.append(QString::fromUtf8(data.constData() + reader.position(), length));
+        reader.skip(length);
+    }
+    reader.setStrings(std::move(strings));
+
+    const quint32 geometryCount = reader.read<quint32>();
+    if (!reader.ok() || geometryCount > static_cast<quint32>(reader.remaining() / (2 * sizeof(quint32)))) {
+        qWarning() << "WorldSnapshot::load - corrupted geometry table";
+        return false;
+    }
+    QVector<GeometryHandle> geometries;
+    geometries.reserve(geometryCount);
+    for (quint32 i = 0; i < geometryCount && reader.ok(); ++i) {
+        const QVector<VertexData> vertices = reader.readArray<VertexData>();
+        const QVector<quint16> indices = reader.readArray<quint16>();
+        geometries.append(GeometryArena::getInstance()->allocate(vertices, indices));
+    }
+    reader.setGeometries(std::move(geometries));
+
+    const QVector<quint32> generations = reader.readArray<quint32>();
+    const QVector<quint32> aliveIndices = reader.readArray<quint32>();
+    if (!reader.ok() || generations.isEmpty()) {
+        qWarning() << "WorldSnapshot::load - corrupted entity table";
+        return false;
+    }
+
+    // --- 恢复实体槽位，句柄与保存时完全一致 ---
+    world.clear();
+    world.mEntitySlots.resize(generations.size());
+    for (qint32 index = 0; index < generations.size(); ++index) {
+        World::EntitySlot &slot = world.mEntitySlots[index];
+        slot.generation = generations[index] == PENDING_ENTITY_GENERATION ? 0 : generations[index];
+        slot.alive = false;
+        slot.componentTypes.clear();
+    }
+    for (const quint32 index: aliveIndices) {
+        if (index == 0 || index >= static_cast<quint32>(generations.size()) || world.mEntitySlots[index].alive) {
+            qWarning() << "WorldSnapshot::load - corrupted entity table";
+            world.clear();
+            return false;
+        }
+        world.mEntitySlots[index].alive = true;
+    }
+    // 倒序放入空闲列表，createEntity 从末尾取，优先复用小下标
+    world.mFreeIndices.clear();
+    for (quint32 index = static_cast<quint32>(generations.size()) - 1; index > 0; --index) {
+        if (!world.mEntitySlots[index].alive) {
+            world.mFreeIndices.append(index);
+        }
+    }
+    world.mStructureChangeTick = world.changeTick();
+
+    // --- 组件块 ---
+    const quint32 blockCount = reader.read<quint32>();
+    QSet<QString> loadedTypes;
+    QVector<quint8> seen(generations.size(), 0);
+    for (quint32 block = 0; block < blockCount && reader.ok(); ++block) {
+        const QString name = reader.readString();
+        const quint32 elementSize = reader.read<quint32>();
+        QVector<EntityID> entities = reader.readArray<EntityID>();
+        const quint64 payloadBytes = reader.read<quint64>();
+        if (!reader.ok() || payloadBytes > static_cast<quint64>(reader.remaining()) || loadedTypes.contains(name)) {
+            reader.fail();
+            break;
+        }
+        const qsizetype payloadEnd = reader.position() + static_cast<qsizetype>(payloadBytes);
+
+        const qint32 serializerIndex = mSerializerByName.value(name, -1);
+        if (serializerIndex < 0 || mSerializers[serializerIndex].elementSize != elementSize) {
+            qWarning() << "WorldSnapshot::load - skipping unknown or outdated component" << name;
+            reader.skip(static_cast<qsizetype>(payloadBytes));
+            continue;
+        }
+
+        // 同一块内不能有重复实体，也不能指向已销毁的槽位
+        bool valid = true;
+        for (const EntityID entity: std::as_const(entities)) {
+            const quint32 index = entityIndex(entity);
+            if (!world.isAlive(entity) || seen[index]) {
+                valid = false;
+                break;
+            }
+            seen[index] = 1;
+        }
+        for (const EntityID entity: std::as_const(entities)) {
+            const quint32 index = entityIndex(entity);
+            if (index < static_cast<quint32>(seen.size())) {
+                seen[index] = 0;
+            }
+        }
+        if (!valid) {
+            reader.fail();
+            break;
+        }
+
+        loadedTypes.insert(name);
+        if (!mSerializers[serializerIndex].load(world, reader, std::move(entities)) || reader.position() != payloadEnd) {
+            reader.fail();
+        }
+    }
+
+    if (!reader.ok()) {
+        qWarning() << "WorldSnapshot::load - corrupted component data";
+        world.clear();
+        return false;
+    }
+    return true;
+}
+
+bool WorldSnapshot::saveToFile(const World &world, const QString &filePath) const {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "WorldSnapshot::saveToFile - cannot open" << filePath;
+        return false;
+    }
+    const QByteArray data = save(world);
+    return file.write(data) == data.size();
+}
+
+bool WorldSnapshot::loadFromFile(World &world, const QString &filePath) const {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "WorldSnapshot::loadFromFile - cannot open" << filePath;
+        return false;
+    }
+    // 一次读入整个文件，之后全部是内存拷贝
+    return load(world, file.readAll());
+}
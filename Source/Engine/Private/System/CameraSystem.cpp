@@ -6,10 +6,16 @@
 #include "Scene/World.h"
 #include "System/InputSystem.h"
 
+SystemAccess CameraSystem::access() const {
+    // 读取 InputSystem 的按键状态，必须留在主线程
+    return SystemAccess().read<CameraComponent>().write<TransformComponent, CameraControllerComponent>().onMainThread();
+}
+
 void CameraSystem::update(World *world, float deltaTime) {
-    auto view = world->view<TransformComponent, CameraComponent, CameraControllerComponent>();
+    const auto &cameras = world->group<TransformComponent, CameraComponent, CameraControllerComponent>();
 
-    for (EntityID entity: view) {
+    for (EntityID entity: cameras) {
+        // 只有相机真的移动时才标记变化，静止的相机不触发下游的增量更新
         auto transform = world->getComponent<TransformComponent>(entity);
         auto controller = world->getComponent<CameraControllerComponent>(entity);
 
@@ -37,6 +43,7 @@ void CameraSystem::update(World *world, float deltaTime) {
 
         if (!movement.isNull()) {
             transform->translate(movement.normalized() * controller->mMoveSpeed * deltaTime);
+            world->markChanged<TransformComponent>(entity);
         }
 
         if (InputSystem::get().isMouseCaptured()) {
@@ -61,6 +68,8 @@ void CameraSystem::update(World *world, float deltaTime) {
             QQuaternion finalRot = yawRot * pitchRot;
 
             transform->setRotation(finalRot);
+            world->markChanged<TransformComponent>(entity);
+            world->markChanged<CameraControllerComponent>(entity);
         }
     }
 }
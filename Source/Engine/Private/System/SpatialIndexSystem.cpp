@@ -0,0 +1,70 @@
+#include "System/SpatialIndexSystem.h"
+
+#include "Component/SingletonComponents.h"
+#include "Component/TransformComponent.h"
+#include "Component/WorldTransformComponent.h"
+#include "Scene/World.h"
+#include "Scene/WorldCommandBuffer.h"
+
+SpatialIndexSystem::SpatialIndexSystem(float cellSize): mCellSize(cellSize) {
+}
+
+bool SpatialIndexSystem::worldPosition(const World &world, EntityID entity, QVector3D &position) {
+    if (const auto *worldTransform = world.getComponent<WorldTransformComponent>(entity)) {
+        position = worldTransform->worldMatrix.column(3).toVector3D();
+        return true;
+    }
+    if (const auto *transform = world.getComponent<TransformComponent>(entity)) {
+        position = transform->position();
+        return true;
+    }
+    return false;
+}
+
+SystemAccess SpatialIndexSystem::access() const {
+    // 只读实体上的变换，写入只落在空间索引单例上，可以和不碰变换的系统并行
+    return SystemAccess().read<TransformComponent, WorldTransformComponent>().write<SpatialIndexSingleton>();
+}
+
+void SpatialIndexSystem::update(World *world, float deltaTime) {
+    Q_UNUSED(deltaTime);
+    auto *index = world->singleton<SpatialIndexSingleton>();
+    if (!index) {
+        // 与其他系统并行时不能直接改动单例表，录制到命令缓冲区在同步点创建；
+        // 从 tick 0 开始，单例出现后的第一次更新经 changedSince(0) 放入全部实体
+        world->commands().setSingleton(SpatialIndexSingleton{{}, SpatialHashGrid(mCellSize)});
+        mLastTick = 0;
+        return;
+    }
+    SpatialHashGrid &grid = index->grid;
+
+    const quint32 since = mLastTick;
+    mLastTick = world->advanceChangeTick();
+
+    QVector3D position;
+
+    // 被销毁或移除了 Transform 的实体没有变更 tick，只能在结构变化后逐个检查
+    if (world->structureChangedSince(since)) {
+        QVector<EntityID> stale;
+        grid.forEachEntity([world, &stale](EntityID entity, const QVector3D &) {
+            if (!world->hasComponent<TransformComponent>(entity)) {
+                stale.append(entity);
+            }
+        });
+        for (EntityID entity: std::as_const(stale)) {
+            grid.remove(entity);
+        }
+    }
+
+    // 层级中的实体看 TransformSystem 写回的世界矩阵，没有世界矩阵缓存的实体看本地 Transform
+    for (EntityID entity: world->changedSince<WorldTransformComponent>(since)) {
+        if (world->hasComponent<TransformComponent>(entity) && worldPosition(*world, entity, position)) {
+            grid.insertOrUpdate(entity, position);
+        }
+    }
+    for (EntityID entity: world->changedSince<TransformComponent>(since)) {
+        if (!world->hasComponent<WorldTransformComponent>(entity) && worldPosition(*world, entity, position)) {
+            grid.insertOrUpdate(entity, position);
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#include "System/TransformSystem.h"
+
+#include <cstring>
+
+#include "Component/HierarchyComponent.h"
+#include "Component/TransformComponent.h"
+#include "Component/WorldTransformComponent.h"
+#include "Scene/JobSystem.h"
+#include "Scene/World.h"
+
+namespace {
+    constexpr qint32 LevelGrain = 256;
+}
+
+bool TransformSystem::setParent(World &world, EntityID child, EntityID parent) {
+    if (!world.isAlive(child)) return false;
+    // 沿 parent 向上查找，遇到 child 说明会形成环；步数上限防止已有数据中的环导致死循环
+    EntityID ancestor = parent;
+    for (qint32 steps = 0; ancestor != INVALID_ENTITY && steps < world.entityCapacity(); ++steps) {
+        if (ancestor == child) return false;
+        const auto *hierarchy = world.getComponent<HierarchyComponent>(ancestor);
+        ancestor = hierarchy ? hierarchy->parent : INVALID_ENTITY;
+    }
+    if (ancestor != INVALID_ENTITY) return false;
+
+    if (auto *hierarchy = world.getMutableComponent<HierarchyComponent>(child)) {
+        hierarchy->parent = parent;
+    } else {
+        world.addComponent(child, HierarchyComponent{{}, parent});
+    }
+    return true;
+}
+
+void TransformSystem::update(World *world, float deltaTime) {
+    Q_UNUSED(deltaTime);
+    const quint32 since = mLastTick;
+    mLastTick = world->advanceChangeTick();
+
+    QVector<EntityID> dirty = world->changedSince<TransformComponent>(since);
+    dirty.append(world->changedSince<HierarchyComponent>(since));
+
+    const bool structureChanged = world->structureChangedSince(since);
+    if (structureChanged) {
+        // 新建的带 Transform 的实体补上世界矩阵缓存，并作为脏节点参与本次传播
+        QVector<EntityID> missing;
+        for (EntityID entity: World::ViewIterator<TransformComponent>(world)) {
+            if (!world->hasComponent<WorldTransformComponent>(entity)) {
+                missing.append(entity);
+            }
+        }
+        for (EntityID entity: std::as_const(missing)) {
+            world->addComponent(entity, WorldTransformComponent{});
+        }
+        dirty.append(missing);
+    }
+    if (structureChanged || world->anyChangedSince<HierarchyComponent>(since)) {
+        rebuildHierarchy(world, dirty);
+    }
+    if (dirty.isEmpty()) return;
+
+    const qint32 capacity = world->entityCapacity();
+    if (mVisited.size() < capacity) {
+        mVisited.resize(capacity, 0);
+    }
+    if (++mVisitEpoch == 0) {
+        mVisited.fill(0);
+        mVisitEpoch = 1;
+    }
+
+    // 脏节点按深度分桶，祖先先于后代处理，同一子树里多个脏节点只会被展开一次
+    mDirtyByDepth.resize(mMaxDepth + 1);
+    for (auto &bucket: mDirtyByDepth) {
+        bucket.clear();
+    }
+    for (EntityID entity: std::as_const(dirty)) {
+        const quint32 index = entityIndex(entity);
+        if (index >= static_cast<quint32>(mDepths.size()) || mDepths[index] < 0) continue;
+        mDirtyByDepth[mDepths[index]].append(entity);
+    }
+
+    QVector<EntityID> current;
+    QVector<EntityID> next;
+    for (qint32 depth = 0; depth <= mMaxDepth; ++depth) {
+        // 本层 = 上一层展开出的子节点 + 本层自身被写过的节点
+        current.append(mDirtyByDepth[depth]);
+        if (current.isEmpty()) continue;
+
+        // 组件指针在主线程串行解析，getMutableComponent 同时给 WorldTransform 打上变更 tick
+        mLevel.clear();
+        mLocals.clear();
+        next.clear();
+        for (EntityID entity: std::as_const(current)) {
+            const quint32 index = entityIndex(entity);
+            if (mVisited[index] == mVisitEpoch) continue;
+            mVisited[index] = mVisitEpoch;
+
+            const EntityID parent = mParents[index];
+            mLocals.append(*world->getComponent<TransformComponent>(entity));
+            mLevel.append(PropagateItem{
+                parent != INVALID_ENTITY ? world->getComponent<WorldTransformComponent>(parent) : nullptr,
+                world->getMutableComponent<WorldTransformComponent>(entity)
+            });
+            for (qint32 c = mChildOffsets[index]; c < mChildOffsets[index + 1]; ++c) {
+                next.append(mChildren[c]);
+            }
+        }
+
+        // 同一层的节点父节点都已算完，彼此独立；每块先成批合成本地矩阵，再逐个乘上父节点的世界矩阵
+        const PropagateItem *items = mLevel.constData();
+        const TransformSoA &locals = mLocals;
+        JobSystem::getInstance()->parallelFor(mLevel.size(), LevelGrain, [items, &locals](qint32 begin, qint32 end) {
+            float localMatrices[LevelGrain * 16];
+            locals.composeMatrices(begin, end, localMatrices, 16 * sizeof(float));
+            for (qint32 i = begin; i < end; ++i) {
+                const float *local = localMatrices + (i - begin) * 16;
+                WorldTransformComponent &worldTransform = *items[i].world;
+                if (items[i].parentWorld) {
+                    QMatrix4x4 localMatrix;
+                    std::memcpy(localMatrix.data(), local, 16 * sizeof(float));
+                    worldTransform.worldMatrix = items[i].parentWorld->worldMatrix * localMatrix;
+                } else {
+                    std::memcpy(worldTransform.worldMatrix.data(), local, 16 * sizeof(float));
+                }
+                worldTransform.normalMatrix = worldTransform.worldMatrix.normalMatrix();
+            }
+        });
+        std::swap(current, next);
+        next.clear();
+    }
+}
+
+void TransformSystem::rebuildHierarchy(World *world, QVector<EntityID> &dirty) {
+    const qint32 capacity = world->entityCapacity();
+    const QVector<EntityID> oldParents = std::move(mParents);
+
+    // 只有父节点存活且带 Transform 时才挂在它下面，否则按根节点处理
+    QVector<EntityID> nodes;
+    mParents = QVector<EntityID>(capacity, INVALID_ENTITY);
+    mChildOffsets = QVector<qint32>(capacity + 1, 0);
+    for (EntityID entity: World::ViewIterator<TransformComponent>(world)) {
+        nodes.append(entity);
+        EntityID parent = INVALID_ENTITY;
+        const auto *hierarchy = world->getComponent<HierarchyComponent>(entity);
+        if (hierarchy && hierarchy->parent != entity && world->hasComponent<TransformComponent>(hierarchy->parent)) {
+            parent = hierarchy->parent;
+            ++mChildOffsets[entityIndex(parent) + 1];
+        }
+        const quint32 index = entityIndex(entity);
+        mParents[index] = parent;
+        // 父节点被销毁或换成了别的实体，世界矩阵需要重新计算
+        if (index >= static_cast<quint32>(oldParents.size()) || oldParents[index] != parent) {
+            dirty.append(entity);
+        }
+    }
+
+    // 子节点表按父节点下标排成连续数组（CSR），广度优先展开时按区间顺序读取
+    for (qint32 i = 0; i < capacity; ++i) {
+        mChildOffsets[i + 1] += mChildOffsets[i];
+    }
+    mChildren = QVector<EntityID>(mChildOffsets[capacity], INVALID_ENTITY);
+    QVector<qint32> cursor(mChildOffsets.begin(), mChildOffsets.end() - 1);
+    for (EntityID entity: std::as_const(nodes)) {
+        const EntityID parent = mParents[entityIndex(entity)];
+        if (parent != INVALID_ENTITY) {
+            mChildren[cursor[entityIndex(parent)]++] = entity;
+        }
+    }
+
+    // 从根节点广度优先计算深度，环上的节点不可达，保持 -1 且不参与传播
+    mDepths = QVector<qint32>(capacity, -1);
+    mMaxDepth = 0;
+    QVector<EntityID> queue;
+    queue.reserve(nodes.size());
+    for (EntityID entity: std::as_const(nodes)) {
+        if (mParents[entityIndex(entity)] == INVALID_ENTITY) {
+            mDepths[entityIndex(entity)] = 0;
+            queue.append(entity);
+        }
+    }
+    for (qint32 head = 0; head < queue.size(); ++head) {
+        const quint32 index = entityIndex(queue[head]);
+        const qint32 childDepth = mDepths[index] + 1;
+        for (qint32 c = mChildOffsets[index]; c < mChildOffsets[index + 1]; ++c) {
+            mDepths[entityIndex(mChildren[c])] = childDepth;
+            mMaxDepth = qMax(mMaxDepth, childDepth);
+            queue.append(mChildren[c]);
+        }
+    }
+}
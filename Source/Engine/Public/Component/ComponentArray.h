@@ -1,74 +1,163 @@
 #pragma once
 
-#include <QHash>
+#include <type_traits>
+#include <QVector>
 
 #include "ECSCore.h"
+#include "Component/SparseSet.h"
 #include "Interface/IComponentArray.h"
 
+/*!
+ * 组件存储：稀疏集 + 与 dense 实体数组一一对应的紧凑组件数组
+ * @note 下标 i 处的组件属于 entities()[i]，遍历时直接线性扫描 data()
+ * @note changeTicks()[i] 记录该组件最后一次被写入时的 World 变更 tick
+ * @note 空结构体（标签组件）只记录成员关系，不存组件数组，data() 始终为空，按下标访问用 at()
+ */
 template<typename T>
 class ComponentArray : public IComponentArray {
 public:
-    void insert(EntityID entity, T component) {
-        if (mEntityToIndex.count(entity)) {
-            mComponents[mEntityToIndex[entity]] = component;
+    static constexpr bool IsTag = std::is_empty_v<T>;
+
+    void insert(EntityID entity, T component, quint32 changeTick = 0) {
+        if (const qint32 index = mEntities.indexOf(entity); index != EntitySparseSet::InvalidIndex) {
+            if constexpr (!IsTag) {
+                mComponents[index] = std::move(component);
+            }
+            mChangeTicks[index] = changeTick;
             return;
         }
-        qint32 newIndex = mSize;
-        mEntityToIndex[entity] = newIndex;
-        mIndexToEntity[newIndex] = entity;
-        if (newIndex >= mComponents.size()) {
-            mComponents.resize(newIndex + 1);
+        mEntities.insert(entity);
+        if constexpr (!IsTag) {
+            mComponents.append(std::move(component));
         }
-        mComponents[newIndex] = component;
-        mSize++;
+        mChangeTicks.append(changeTick);
     }
 
     void remove(EntityID entity) {
-        if (!mEntityToIndex.count(entity)) return;
-
-        qint32 indexOfRemoved = mEntityToIndex[entity];
-        qint32 indexOfLast = mSize - 1;
-        mComponents[indexOfRemoved] = mComponents[indexOfLast];
+        const qint32 index = mEntities.remove(entity);
+        if (index == EntitySparseSet::InvalidIndex) return;
 
-        EntityID entityOfLast = mIndexToEntity[indexOfLast];
-        mEntityToIndex[entityOfLast] = indexOfRemoved;
-        mIndexToEntity[indexOfRemoved] = entityOfLast;
-
-        mEntityToIndex.remove(entity);
-        mIndexToEntity.remove(indexOfLast);
-        mSize--;
+        if (index != mChangeTicks.size() - 1) {
+            if constexpr (!IsTag) {
+                mComponents[index] = std::move(mComponents.last());
+            }
+            mChangeTicks[index] = mChangeTicks.last();
+        }
+        if constexpr (!IsTag) {
+            mComponents.removeLast();
+        }
+        mChangeTicks.removeLast();
     }
 
     void removeEntity(EntityID entity) override {
         remove(entity);
     }
 
+    // 批量追加同一个组件值，存储只扩容一次；调用方需保证这些实体都不在数组中
+    void insertBatch(const QVector<EntityID> &entities, const T &component, quint32 changeTick = 0) {
+        reserve(size() + entities.size());
+        for (const EntityID entity: entities) {
+            mEntities.insert(entity);
+        }
+        if constexpr (!IsTag) {
+            mComponents.insert(mComponents.size(), entities.size(), component);
+        }
+        mChangeTicks.insert(mChangeTicks.size(), entities.size(), changeTick);
+    }
+
+    // 批量追加各不相同的组件，entities[i] 对应 components[i]；数组为空时直接接管 components 的存储
+    void insertRange(const QVector<EntityID> &entities, QVector<T> components, quint32 changeTick = 0) {
+        mEntities.reserve(size() + entities.size());
+        for (const EntityID entity: entities) {
+            mEntities.insert(entity);
+        }
+        if constexpr (!IsTag) {
+            if (mComponents.isEmpty()) {
+                mComponents = std::move(components);
+            } else {
+                mComponents.append(std::move(components));
+            }
+        }
+        mChangeTicks.insert(mChangeTicks.size(), entities.size(), changeTick);
+    }
+
+    void cloneEntity(EntityID source, const QVector<EntityID> &targets, quint32 changeTick) override {
+        const T *prototype = get(source);
+        if (!prototype) return;
+        // 先复制一份，insertBatch 扩容会使指向数组内部的指针失效
+        const T component = *prototype;
+        insertBatch(targets, component, changeTick);
+    }
+
+    void collectChangedSince(quint32 sinceTick, QVector<EntityID> &out) const override {
+        for (qint32 i = 0; i < mChangeTicks.size(); ++i) {
+            if (mChangeTicks[i] > sinceTick) {
+                out.append(mEntities.entities()[i]);
+            }
+        }
+    }
 
     T *get(EntityID entity) {
-        if (!mEntityToIndex.count(entity)) return nullptr;
-        return &mComponents[mEntityToIndex[entity]];
+        const qint32 index = mEntities.indexOf(entity);
+        return index == EntitySparseSet::InvalidIndex ? nullptr : &at(index);
     }
 
     const T *get(EntityID entity) const {
-        if (!mEntityToIndex.count(entity)) return nullptr;
-        return &mComponents[mEntityToIndex[entity]];
+        const qint32 index = mEntities.indexOf(entity);
+        return index == EntitySparseSet::InvalidIndex ? nullptr : &at(index);
+    }
+
+    // dense 下标 index 处的组件；标签组件没有状态，所有实体共用同一个实例
+    T &at(qint32 index) {
+        if constexpr (IsTag) {
+            return sTag;
+        } else {
+            return mComponents[index];
+        }
+    }
+
+    const T &at(qint32 index) const {
+        if constexpr (IsTag) {
+            return sTag;
+        } else {
+            return mComponents[index];
+        }
+    }
+
+    // 记录组件被写入，返回组件指针；实体不存在时返回 nullptr
+    T *markChanged(EntityID entity, quint32 changeTick) {
+        const qint32 index = mEntities.indexOf(entity);
+        if (index == EntitySparseSet::InvalidIndex) return nullptr;
+        mChangeTicks[index] = changeTick;
+        return &at(index);
+    }
+
+    void reserve(qint32 capacity) {
+        mEntities.reserve(capacity);
+        if constexpr (!IsTag) {
+            mComponents.reserve(capacity);
+        }
+        mChangeTicks.reserve(capacity);
     }
 
-    std::vector<T> &data() { return mComponents; }
-    qint32 size() const { return mSize; }
+    QVector<T> &data() { return mComponents; }
+    const QVector<T> &data() const { return mComponents; }
+    const QVector<EntityID> &entities() const { return mEntities.entities(); }
+    const QVector<quint32> &changeTicks() const { return mChangeTicks; }
+    qint32 size() const { return mEntities.size(); }
 
     EntityID getEntity(const qint32 index) const {
-        if (mIndexToEntity.count(index)) return mIndexToEntity[index];
-        return INVALID_ENTITY;
+        if (index < 0 || index >= mEntities.size()) return INVALID_ENTITY;
+        return mEntities.at(index);
     }
 
     bool hasEntity(EntityID entity) const {
-        return mEntityToIndex.count(entity);
+        return mEntities.contains(entity);
     }
 
 private:
+    EntitySparseSet mEntities;
     QVector<T> mComponents;
-    QHash<EntityID, qint32> mEntityToIndex;
-    QHash<qint32, EntityID> mIndexToEntity;
-    qint32 mSize = 0;
+    QVector<quint32> mChangeTicks;
+    static inline T sTag{};
 };
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Component.h"
+#include "ECSCore.h"
+
+/*!
+ * 父子层级，只保存父节点句柄
+ * 子节点列表由 TransformSystem 在结构变化时重建为连续数组，不在组件里维护链表，销毁实体不会留下悬空的兄弟指针
+ * @note 父节点已销毁时该实体按根节点处理
+ */
+struct HierarchyComponent : Component {
+    EntityID parent = INVALID_ENTITY;
+};
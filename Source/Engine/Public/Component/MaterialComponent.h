@@ -4,8 +4,30 @@
 #include <QString>
 #include "Component.h"
 #include "CommonRender.h"
+#include "Scene/StringTable.h"
 
 struct MaterialComponent : Component {
+    // 默认纹理只驻留一次，构造组件时只拷贝 id；用函数内静态变量，保证在 CommonRender.h 的常量之后初始化
+    static InternedString whiteTexture() {
+        static const InternedString id(DEFAULT_WHITE_TEXTURE_ID);
+        return id;
+    }
+
+    static InternedString blackTexture() {
+        static const InternedString id(DEFAULT_BLACK_TEXTURE_ID);
+        return id;
+    }
+
+    static InternedString normalTexture() {
+        static const InternedString id(DEFAULT_NORMAL_MAP_ID);
+        return id;
+    }
+
+    static InternedString metalRoughTexture() {
+        static const InternedString id(DEFAULT_METALROUGH_TEXTURE_ID);
+        return id;
+    }
+
     // PBR Parameters
     QVector3D albedoFactor = {1.0f, 1.0f, 1.0f};
     float metallicFactor = 0.1f;
@@ -13,10 +35,13 @@ struct MaterialComponent : Component {
     QVector3D emissiveFactor = {0.0f, 0.0f, 0.0f};
     float aoStrength = 1.0f;
     // PBR Texture Map Resource IDs
-    QString albedoMapResourceId = DEFAULT_WHITE_TEXTURE_ID;
-    QString specularMapResourceId = DEFAULT_WHITE_TEXTURE_ID;
-    QString normalMapResourceId = DEFAULT_NORMAL_MAP_ID;
-    QString metallicRoughnessMapResourceId = DEFAULT_METALROUGH_TEXTURE_ID;
-    QString ambientOcclusionMapResourceId = DEFAULT_WHITE_TEXTURE_ID;
-    QString emissiveMapResourceId = DEFAULT_BLACK_TEXTURE_ID;
+    InternedString albedoMapResourceId = whiteTexture();
+    InternedString specularMapResourceId = whiteTexture();
+    InternedString normalMapResourceId = normalTexture();
+    InternedString metallicRoughnessMapResourceId = metalRoughTexture();
+    InternedString ambientOcclusionMapResourceId = whiteTexture();
+    InternedString emissiveMapResourceId = blackTexture();
 };
+
+// 纹理路径都是驻留句柄，组件数组可以按字节搬运
+static_assert(std::is_trivially_copyable_v<MaterialComponent>);
@@ -2,11 +2,20 @@
 
 #include "Component.h"
 #include "CommonRender.h"
+#include "Scene/GeometryArena.h"
+#include "Scene/StringTable.h"
 
 struct MeshComponent : Component {
-    QVector<VertexData> vertices;
-    QVector<quint16> indices;
+    static InternedString builtinCube() {
+        static const InternedString id(BUILTIN_CUBE_MESH_ID);
+        return id;
+    }
+
+    // 导入模型的 CPU 几何体，内置网格没有
+    GeometryHandle geometry;
     bool rhiDataDirty = true;
 
-    QString meshResourceId = BUILTIN_CUBE_MESH_ID;
+    InternedString meshResourceId = builtinCube();
 };
+
+static_assert(std::is_trivially_copyable_v<MeshComponent>);
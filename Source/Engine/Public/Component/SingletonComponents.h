@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Component.h"
+#include "ECSCore.h"
+#include "Scene/SpatialHashGrid.h"
+
+/*!
+ * World 级单例组件，通过 World::setSingleton / singleton 以 O(1) 读写
+ * 只保存实体句柄，实体被销毁后句柄失效，使用方需用 World::isAlive 检查
+ */
+
+// 当前用于渲染的相机
+struct ActiveCameraSingleton : Component {
+    EntityID camera = INVALID_ENTITY;
+};
+
+// 主方向光，BasePass 直接取它填充 Lighting UBO 的方向光
+struct MainDirectionalLightSingleton : Component {
+    EntityID light = INVALID_ENTITY;
+};
+
+// 带 Transform 的实体按世界坐标位置建立的空间索引，由 SpatialIndexSystem 维护，其他代码只读
+struct SpatialIndexSingleton : Component {
+    SpatialHashGrid grid;
+};
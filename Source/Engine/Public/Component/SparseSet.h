@@ -0,0 +1,90 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <QVector>
+
+#include "ECSCore.h"
+
+/*!
+ * 分页稀疏集：dense 数组保存实体句柄，sparse 分页以实体槽位下标保存 dense 下标
+ * @note 查找/插入/删除均为 O(1)，不做任何哈希；删除时与末尾元素交换，遍历 dense 数组即为线性访问
+ */
+class EntitySparseSet {
+public:
+    static constexpr qint32 InvalidIndex = -1;
+    static constexpr quint32 PageShift = 12;
+    static constexpr quint32 PageSize = 1u << PageShift;
+    static constexpr quint32 PageMask = PageSize - 1;
+
+    qint32 indexOf(EntityID entity) const {
+        const quint32 index = entityIndex(entity);
+        const quint32 page = index >> PageShift;
+        if (page >= mSparsePages.size() || !mSparsePages[page]) return InvalidIndex;
+        const qint32 denseIndex = mSparsePages[page][index & PageMask];
+        // 比较完整句柄，同一槽位上的旧代数句柄不会命中
+        if (denseIndex == InvalidIndex || mDense[denseIndex] != entity) return InvalidIndex;
+        return denseIndex;
+    }
+
+    bool contains(EntityID entity) const {
+        return indexOf(entity) != InvalidIndex;
+    }
+
+    // 追加到 dense 末尾并返回下标，调用方需保证实体不在集合内
+    qint32 insert(EntityID entity) {
+        const qint32 denseIndex = mDense.size();
+        sparseSlot(entity) = denseIndex;
+        mDense.append(entity);
+        return denseIndex;
+    }
+
+    /**
+     * @brief 交换删除实体。
+     * @return 被删除实体原来的 dense 下标（此时该位置已被原末尾元素占据），不存在时返回 InvalidIndex。
+     * 调用方需要对并行的数据数组做相同的交换删除。
+     */
+    qint32 remove(EntityID entity) {
+        const qint32 denseIndex = indexOf(entity);
+        if (denseIndex == InvalidIndex) return InvalidIndex;
+
+        const EntityID last = mDense.last();
+        mDense[denseIndex] = last;
+        sparseSlot(last) = denseIndex;
+        sparseSlot(entity) = InvalidIndex;
+        mDense.removeLast();
+        return denseIndex;
+    }
+
+    void clear() {
+        for (const EntityID entity: std::as_const(mDense)) {
+            sparseSlot(entity) = InvalidIndex;
+        }
+        mDense.clear();
+    }
+
+    void reserve(qint32 capacity) { mDense.reserve(capacity); }
+
+    qint32 size() const { return mDense.size(); }
+    bool isEmpty() const { return mDense.isEmpty(); }
+    EntityID at(qint32 denseIndex) const { return mDense[denseIndex]; }
+    const QVector<EntityID> &entities() const { return mDense; }
+
+private:
+    qint32 &sparseSlot(EntityID entity) {
+        const quint32 index = entityIndex(entity);
+        const quint32 page = index >> PageShift;
+        if (page >= mSparsePages.size()) {
+            mSparsePages.resize(page + 1);
+        }
+        if (!mSparsePages[page]) {
+            mSparsePages[page] = std::make_unique<qint32[]>(PageSize);
+            std::fill_n(mSparsePages[page].get(), PageSize, InvalidIndex);
+        }
+        return mSparsePages[page][index & PageMask];
+    }
+
+    QVector<EntityID> mDense;
+    // 按需分配的分页，槽位下标会被回收复用，分页数量取决于同时存活的实体数
+    std::vector<std::unique_ptr<qint32[]> > mSparsePages;
+};
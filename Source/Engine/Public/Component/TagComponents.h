@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Component.h"
+
+/*!
+ * 标签组件：空结构体，只表示实体属于某个集合
+ * ComponentArray 和 Archetype chunk 都不为它们保存逐实体的数据，只记录成员关系和变更 tick
+ * @note 需要按标签筛选时用 group<..., Tag>()，成员表增量维护，不扫描组件数组
+ */
+
+// 可作为渲染视角的相机，ActiveCameraSingleton 未设置或已失效时 BasePass 从带此标签的相机中选取
+struct ActiveCameraTag : Component {
+};
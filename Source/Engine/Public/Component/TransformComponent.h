@@ -7,13 +7,17 @@
 
 #include "Component.h"
 
+/*!
+ * 相对父节点的本地变换，没有 HierarchyComponent 时即为世界变换
+ * @note 层级中的世界矩阵由 TransformSystem 缓存在 WorldTransformComponent 中
+ */
 struct TransformComponent : public Component {
 public:
-    QMatrix4x4 worldMatrix() const;
+    QMatrix4x4 localMatrix() const;
 
     QMatrix3x3 normalMatrix() const;
 
-    QVector3D position() { return mPosition; }
+    QVector3D position() const { return mPosition; }
 
     void translate(const QVector3D &translation);
 
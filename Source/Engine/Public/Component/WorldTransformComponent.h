@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QMatrix4x4>
+
+#include "Component.h"
+
+/*!
+ * TransformSystem 维护的世界矩阵缓存，等于父节点世界矩阵 * 本地 TRS
+ * 同时缓存法线矩阵（世界矩阵左上 3x3 的逆转置），只在 Transform 或层级变化时重新计算，渲染时按实例上传
+ * @note 只由 TransformSystem 写入，其他系统只读；不写入场景快照，读回后重新计算
+ */
+struct WorldTransformComponent : Component {
+    QMatrix4x4 worldMatrix;
+    QMatrix3x3 normalMatrix;
+};
@@ -1,7 +1,17 @@
 #pragma once
 
+#include <QVector>
+
+#include "ECSCore.h"
+
 class IComponentArray{
 public:
     virtual ~IComponentArray() = default;
     virtual void removeEntity(EntityID entity) = 0;
+
+    // 把 source 的组件复制给 targets 中的每个实体，targets 必须都还没有该组件
+    virtual void cloneEntity(EntityID source, const QVector<EntityID> &targets, quint32 changeTick) = 0;
+
+    // 把变更 tick 大于 sinceTick 的实体追加到 out
+    virtual void collectChangedSince(quint32 sinceTick, QVector<EntityID> &out) const = 0;
 };
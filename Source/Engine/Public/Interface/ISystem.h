@@ -1,9 +1,54 @@
 #pragma once
 
+#include <QVector>
+
+#include "ECSCore.h"
+
 class World;
 
+/*!
+ * 系统声明的组件访问集合，SystemManager 据此判断哪些系统可以并行执行
+ * @note 并行是按需开启的：没有重写 ISystem::access() 的系统视为独占，在主线程与其他所有系统串行；
+ * 只有不做结构性修改（增删实体或组件）的系统才应声明读写集合
+ */
+struct SystemAccess {
+    QVector<ComponentTypeID> reads;
+    QVector<ComponentTypeID> writes;
+    bool exclusive = false;
+    // 需要访问 Qt GUI 对象（例如 InputSystem）的系统只能在调用 updateAll 的线程执行
+    bool mainThread = false;
+
+    template<typename... Ts>
+    SystemAccess &read() {
+        (reads.append(getComponentTypeID<Ts>()), ...);
+        return *this;
+    }
+
+    template<typename... Ts>
+    SystemAccess &write() {
+        (writes.append(getComponentTypeID<Ts>()), ...);
+        return *this;
+    }
+
+    SystemAccess &onMainThread() {
+        mainThread = true;
+        return *this;
+    }
+
+    static SystemAccess exclusiveAccess() {
+        SystemAccess access;
+        access.exclusive = true;
+        access.mainThread = true;
+        return access;
+    }
+
+    bool conflictsWith(const SystemAccess &other) const;
+};
+
 class ISystem {
 public:
     virtual ~ISystem() = default;
     virtual void update(World* world, float deltaTime) = 0;
+
+    virtual SystemAccess access() const { return SystemAccess::exclusiveAccess(); }
 };
@@ -1,17 +1,23 @@
 #pragma once
+#include <QHash>
+#include <QSet>
+
 #include "ECSCore.h"
 #include "RGPass.h"
 #include "RGResourceRef.h"
 
 struct InstanceUniformBlock;
+struct InstanceNormalUniformBlock;
+struct RenderInstanceProxy;
+struct RenderSceneFrame;
+class RenderScene;
 
 class BasePass : public RGPass {
 public:
     BasePass(const QString &name);
-    ~BasePass() override = default;
 
     struct Input {
-        // base pass 无输入，从场景数据读取
+        // base pass 无输入，从 RenderScene 的前台帧读取场景数据
     };
 
     struct Output {
@@ -28,11 +34,33 @@ public:
     Output getOutput() const { return mOutput; }
 
 private:
-    void updateUniforms(QRhiResourceUpdateBatch *batch);
+    void updateUniforms(QRhiResourceUpdateBatch *batch, const RenderSceneFrame &frame);
 
     void uploadInstanceData(QRhiResourceUpdateBatch *batch, int instanceCount);
 
-    void findActiveCamera();
+    enum class DrawKeyStatus {
+        NotDrawable,
+        Ready,
+        // 资源尚未就绪，下一帧重试
+        Pending
+    };
+
+    // 解析实例的 mesh/material 键，并按需加载或排队上传对应的 GPU 资源
+    DrawKeyStatus resolveDrawKey(const RenderInstanceProxy &proxy, QRhiResourceUpdateBatch *resourceBatch,
+                                 QString &meshId, QString &materialId);
+
+    // 清空分桶，把快照中全部实例放入待处理集合
+    void resetDrawBuckets(const RenderSceneFrame &frame);
+
+    // 把待处理实体重新归桶，返回是否有桶发生变化
+    bool updateDrawBuckets(const RenderSceneFrame &frame, QRhiResourceUpdateBatch *resourceBatch);
+
+    void addToDrawBucket(EntityID entity, const QString &meshId, const QString &materialId);
+
+    void removeFromDrawBucket(EntityID entity);
+
+    // 按桶重新排布实例区间，并按绘制顺序写入全部实例数据
+    void layoutDrawBatches(const RenderSceneFrame &frame);
 
     Output mOutput;
 
@@ -40,14 +68,44 @@ private:
     RGBufferRef mCameraUboRef;
     RGBufferRef mLightingUboRef;
     RGBufferRef mInstanceUboRef;
+    RGBufferRef mInstanceNormalUboRef;
     RGPipelineRef mPipelineRef;
     RGShaderResourceBindingsRef mBaseSrbLayoutRef;
     RGSamplerRef mDefaultSamplerRef;
 
     // data buffer (CPU)
     QVector<InstanceUniformBlock> mInstanceDataBuffer;
+    QVector<InstanceNormalUniformBlock> mInstanceNormalBuffer;
     int mMaxInstances = 1024;
     quint32 mInstanceBlockAlignedSize = 0;
 
-    EntityID mActiveCamera = INVALID_ENTITY;
+    QSharedPointer<RenderScene> mRenderScene;
+
+    // 跨帧缓存的绘制批次，实例下标区间 [firstInstance, firstInstance + instanceCount)
+    struct DrawBatch {
+        QString meshId;
+        QString materialId;
+        qint32 firstInstance = 0;
+        qint32 instanceCount = 0;
+    };
+
+    QVector<DrawBatch> mDrawBatches;
+    QHash<EntityID, qint32> mInstanceIndexByEntity;
+    qint32 mInstanceCount = 0;
+
+    // 按 mesh -> material 分桶的可绘制实体，跨帧保留，只对发生变化的实体重新归桶
+    QHash<QString, QHash<QString, QVector<EntityID> > > mEntitiesByMeshThenMaterial;
+
+    // 实体所在的桶和桶内下标，用于 O(1) 交换删除
+    struct DrawSlot {
+        QString meshId;
+        QString materialId;
+        qint32 index = 0;
+    };
+
+    QHash<EntityID, DrawSlot> mDrawSlotByEntity;
+    // 快照报告 mesh/material/可见性变化过、以及资源未就绪的实体，下一帧重新解析
+    QSet<EntityID> mPendingEntities;
+    // 实例 UBO 重建后需要重新解析全部实体
+    bool mDrawBucketsValid = false;
 };
@@ -2,9 +2,11 @@
 #include <QString>
 #include <rhi/qrhi.h>
 
+#include "RGResource.h"
 #include "RGResourceRef.h"
 
 class World;
+class RenderScene;
 class ResourceManager;
 class QSize;
 class RGPass;
@@ -19,11 +21,18 @@ public:
     RGTextureRef createTexture(const QString &name, const QSize &size, QRhiTexture::Format format,
                                int sampleCount = 1, QRhiTexture::Flags flags = {});
 
+    // 以 RGSize::relative 声明的纹理随输出尺寸缩放，窗口大小变化时只重建它们
+    RGTextureRef createTexture(const QString &name, const RGSize &size, QRhiTexture::Format format,
+                               int sampleCount = 1, QRhiTexture::Flags flags = {});
+
     RGBufferRef createBuffer(const QString &name, QRhiBuffer::Type type, QRhiBuffer::UsageFlags usage, quint32 size);
 
     RGRenderBufferRef setupRenderBuffer(const QString &name, QRhiRenderBuffer::Type type, const QSize &size,
                                         int sampleCount = 1, QRhiRenderBuffer::Flags flags = {});
 
+    RGRenderBufferRef setupRenderBuffer(const QString &name, QRhiRenderBuffer::Type type, const RGSize &size,
+                                        int sampleCount = 1, QRhiRenderBuffer::Flags flags = {});
+
     RGRenderTargetRef setupRenderTarget(const QString &name, const QVector<RGTextureRef> &colorRefs,
                                         RGResourceRef dsRef = {});
 
@@ -46,12 +55,17 @@ public:
     RGTextureRef writeTexture(const QString &name, const QSize &size, QRhiTexture::Format format,
                               int sampleCount = 1, QRhiTexture::Flags flags = {});
 
+    RGTextureRef writeTexture(const QString &name, const RGSize &size, QRhiTexture::Format format,
+                              int sampleCount = 1, QRhiTexture::Flags flags = {});
+
     // 一个 Pass 会读取这个纹理
     RGTextureRef readTexture(const QString &name);
 
     // 声入深度/模板缓冲
     RGRenderBufferRef writeDepthStencil(const QString &name, const QSize &size, int sampleCount = 1);
 
+    RGRenderBufferRef writeDepthStencil(const QString &name, const RGSize &size, int sampleCount = 1);
+
     // 读取深度缓冲
     RGRenderBufferRef readDepthStencil(const QString &name);
 
@@ -84,6 +98,8 @@ public:
 
     QSharedPointer<World> world() const;
 
+    QSharedPointer<RenderScene> renderScene() const;
+
     const QSize &outputSize() const;
 
     QRhiRenderPassDescriptor *getSwapchainRpDesc() const;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QSet>
 #include <QSharedPointer>
 #include <QString>
 
@@ -23,11 +24,28 @@ public:
 
     virtual void execute(QRhiCommandBuffer *cmdBuffer) = 0;
 
+    // setup 中通过 RGBuilder 声明的读写资源名，compile() 据此建立 pass 之间的依赖
+    const QSet<QString> &reads() const { return mReads; }
+    const QSet<QString> &writes() const { return mWrites; }
+
+    // 输出没有被屏幕或导出资源用到，本次编译不执行
+    bool isCulled() const { return mCulled; }
+
 protected:
     QString mName;
     QRhi *mRhi = nullptr;
     QSharedPointer<ResourceManager> mResourceManager;
     QSharedPointer<World> mWorld;
     RenderGraph* mGraph = nullptr;
+
+    QSet<QString> mReads;
+    QSet<QString> mWrites;
+    // 声明读取时图中还不存在的资源，写入它的 pass 完成 setup 后本 pass 会重新 setup
+    QSet<QString> mUnresolvedReads;
+    // setup 中创建或引用过的全部资源，pass 被剔除时只被它用到的资源不创建 RHI 对象
+    QSet<QString> mUsedResources;
+    bool mCulled = false;
+
     friend class RenderGraph;
+    friend class RGBuilder;
 };
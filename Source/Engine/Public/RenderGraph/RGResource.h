@@ -5,6 +5,25 @@
 
 #include "RGResourceRef.h"
 
+/*!
+ * 纹理/渲染缓冲的尺寸类别：固定像素尺寸，或相对输出尺寸的比例
+ * @note 相对尺寸的资源在 RenderGraph::setOutputSize 时直接更新描述，窗口缩放不需要重新 setup pass
+ */
+struct RGSize {
+    static RGSize fixed(const QSize &size) { return {false, size, 1.0f}; }
+    static RGSize relative(float scale = 1.0f) { return {true, QSize(), scale}; }
+
+    // 按输出尺寸求实际像素尺寸，相对尺寸每边至少 1 像素
+    QSize resolve(const QSize &outputSize) const {
+        if (!isRelative) return fixedSize;
+        return {qMax(1, qRound(outputSize.width() * scale)), qMax(1, qRound(outputSize.height() * scale))};
+    }
+
+    bool isRelative = false;
+    QSize fixedSize;
+    float scale = 1.0f;
+};
+
 class RGResource {
 public:
     enum class Type { Texture, Buffer, RenderBuffer, RenderTarget, Pipeline, ShaderResourceBindings, Sampler };
@@ -16,6 +35,9 @@ public:
 
     virtual bool build(QRhi *inRhi) = 0;
 
+    // 描述（创建 RHI 对象所需的全部参数，含所依赖资源的描述）的哈希，compile() 只重建哈希变化的资源
+    virtual size_t descriptorHash() const = 0;
+
     const QString &name() const { return mName; }
     Type type() const { return mType; }
 
@@ -35,11 +57,14 @@ class RGTexture : public RGResource {
 public:
     RGTexture(const QString &name, const QSize &size, QRhiTexture::Format format, int sampleCount = 1,
               QRhiTexture::Flags flags = {})
-        : RGResource(name, Type::Texture), mSize(size), mFormat(format), mSampleCount(sampleCount), mFlags(flags) {
+        : RGResource(name, Type::Texture), mSize(size), mSizeSpec(RGSize::fixed(size)), mFormat(format),
+          mSampleCount(sampleCount), mFlags(flags) {
     }
 
     bool build(QRhi *inRhi) override;
 
+    size_t descriptorHash() const override;
+
     QSize size() const { return mSize; }
     QRhiTexture::Format format() const { return mFormat; }
     int sampleCount() const { return mSampleCount; }
@@ -47,8 +72,15 @@ public:
 
     void setSize(const QSize &size) { mSize = size; }
 
+    const RGSize &sizeSpec() const { return mSizeSpec; }
+    void setSizeSpec(const RGSize &sizeSpec) { mSizeSpec = sizeSpec; }
+
+    // 相对尺寸且像素尺寸随输出变化时更新描述并返回 true
+    bool resizeToOutput(const QSize &outputSize);
+
 private:
     QSize mSize;
+    RGSize mSizeSpec;
     QRhiTexture::Format mFormat;
     int mSampleCount;
     QRhiTexture::Flags mFlags;
@@ -62,6 +94,8 @@ public:
 
     bool build(QRhi *inRhi) override;
 
+    size_t descriptorHash() const override;
+
     QRhiBuffer::Type bufType() const { return mBufType; }
     QRhiBuffer::UsageFlags usage() const { return mUsage; }
     quint32 size() const { return mSize; }
@@ -77,11 +111,13 @@ public:
     RGRenderBuffer(const QString &name, QRhiRenderBuffer::Type type, const QSize &size, int sampleCount = 1,
                    QRhiRenderBuffer::Flags flags = {})
         : RGResource(name, Type::RenderBuffer),
-          mRbType(type), mSize(size), mSampleCount(sampleCount), mFlags(flags) {
+          mRbType(type), mSize(size), mSizeSpec(RGSize::fixed(size)), mSampleCount(sampleCount), mFlags(flags) {
     }
 
     bool build(QRhi *inRhi) override;
 
+    size_t descriptorHash() const override;
+
     QRhiRenderBuffer::Type rbType() const { return mRbType; }
     QSize size() const { return mSize; }
     int sampleCount() const { return mSampleCount; }
@@ -89,9 +125,15 @@ public:
 
     void setSize(const QSize &size) { mSize = size; }
 
+    const RGSize &sizeSpec() const { return mSizeSpec; }
+    void setSizeSpec(const RGSize &sizeSpec) { mSizeSpec = sizeSpec; }
+
+    bool resizeToOutput(const QSize &outputSize);
+
 private:
     QRhiRenderBuffer::Type mRbType;
     QSize mSize;
+    RGSize mSizeSpec;
     int mSampleCount;
     QRhiRenderBuffer::Flags mFlags;
 };
@@ -106,6 +148,8 @@ public:
 
     bool build(QRhi *inRhi) override;
 
+    size_t descriptorHash() const override;
+
     const QVector<RGTextureRef> &colorAttachmentRefs() const { return mColorAttachmentRefs; }
     RGResourceRef depthStencilAttachmentRef() const { return mDepthStencilAttachmentRef; }
 
@@ -113,6 +157,12 @@ public:
 
     bool isExternal() const { return mIsExternalRpDesc; }
 
+    // 只含附件格式和采样数、不含尺寸的哈希，管线据此判断 render pass 是否兼容，窗口缩放不必重建管线
+    size_t formatHash() const;
+
+    // 替换附件，已创建的 RHI 对象随之失效
+    void setAttachments(const QVector<RGTextureRef> &colorAttachmentRefs, RGResourceRef depthStencilRef);
+
     QSize getPixelSize() const;
 
     int getSampleCount() const;
@@ -163,6 +213,8 @@ public:
 
     bool build(QRhi *inRhi) override;
 
+    size_t descriptorHash() const override;
+
     RGShaderResourceBindingsRef srbLayoutRef() const { return mSrbLayoutRef; }
     RGRenderTargetRef renderTargetRef() const { return mRenderTargetRef; }
 
@@ -225,6 +277,8 @@ public:
 
     bool build(QRhi *inRhi) override;
 
+    size_t descriptorHash() const override;
+
     const QVector<QRhiShaderResourceBinding> &bindings() const { return mBindings; }
 
 private:
@@ -245,6 +299,8 @@ public:
 
     bool build(QRhi *inRhi) override;
 
+    size_t descriptorHash() const override;
+
     QRhiSampler::Filter magFilter() const { return mMagFilter; }
     QRhiSampler::Filter minFilter() const { return mMinFilter; }
     QRhiSampler::Filter mipmapMode() const { return mMipmapMode; }
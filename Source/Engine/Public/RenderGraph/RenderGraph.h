@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QHash>
+#include <QSet>
 #include <QSharedPointer>
 #include <QSizeF>
 #include <QDebug>
@@ -10,6 +11,7 @@ class RGPass;
 class RGResource;
 class QRhiCommandBuffer;
 class World;
+class RenderScene;
 class QRhi;
 class ResourceManager;
 
@@ -26,14 +28,29 @@ public:
     template<typename PassType, typename... Args>
     PassType *addPass(const QString &name, Args &&... inArgs);
 
-    // 添加完pass后调用
+    /**
+     * @brief 添加完 pass 后调用。
+     *
+     * 依次 setup 所有 pass，按 RGBuilder 记录的读写声明建立依赖图并拓扑排序得到执行顺序，pass 可以按任意顺序添加。
+     * 依赖图有环时报告环上的 pass 并放弃编译。
+     * 从写入 SwapChainRenderTargetProxy 或导出资源的 pass 反向遍历，输出没有被用到的 pass 及只属于它们的资源会被剔除。
+     * 生命周期（按执行顺序的首次/末次使用）不重叠且描述相同的瞬态纹理和渲染缓冲共用同一个 RHI 对象。
+     * 没有被 addPass/setOutputSize/exportResource/invalidate 作废时直接返回；否则只重建描述哈希变化的资源，
+     * 所有 pass 的 setup 结果都与上次相同时不触碰任何 RHI 对象。
+     */
     void compile();
 
+    // 编译得到的执行顺序
+    const QVector<RGPass *> &executionOrder() const { return mExecutionOrder; }
+
     // 编译后调用
     void execute(QRhiSwapChain *swapChain);
 
     bool isCompiled() const { return mCompiled; }
 
+    // pass 的 setup 依赖图外状态（着色器、开关等）且该状态改变时调用，下次 compile() 重新 setup
+    void invalidate() { mCompiled = false; }
+
     // --- 资源管理 ---
     QSharedPointer<RGResource> findResource(const QString &name) const;
 
@@ -50,10 +67,19 @@ public:
 
     bool removeResource(const QString &name);
 
+    // 导出的资源与屏幕一样作为依赖图的终点，写入它的 pass 及其依赖不会被剔除（例如编辑器读取的调试视图）
+    // 导出的资源也不参与别名，跨帧保留内容的纹理（历史帧等）需要导出
+    void exportResource(const QString &name);
+
+    void unexportResource(const QString &name);
+
+    bool isResourceExported(const QString &name) const { return mExportedResources.contains(name); }
+
     // --- Getters ---
     QRhi *getRhi() const { return mRhi; }
     QSharedPointer<ResourceManager> getResourceManager() const { return mResourceManager; }
     QSharedPointer<World> getWorld() const { return mWorld; }
+    QSharedPointer<RenderScene> getRenderScene() const { return mRenderScene; }
     const QSize &getOutputSize() const { return mOutputSize; }
     QRhiRenderPassDescriptor *getSwapChainRpDesc() const { return mSwapChainRpDesc; }
 
@@ -64,17 +90,48 @@ public:
     // --- Setters ---
     void setCommandBuffer(QRhiCommandBuffer *cmdBuffer);
 
+    /**
+     * @brief 更新输出尺寸。
+     *
+     * 只更新以 RGSize::relative 声明的纹理和渲染缓冲的描述，不作废编译结果；下次 compile() 只重建这些资源和挂着它们的
+     * render target，不重新 setup pass，固定尺寸的资源和管线保持不变。
+     */
     void setOutputSize(const QSize &size);
 
+    // 渲染端读取的场景快照，设置后 pass 应从这里取场景数据，而不是直接访问 World
+    void setRenderScene(QSharedPointer<RenderScene> renderScene) { mRenderScene = std::move(renderScene); }
+
 private:
+    // 调用各 pass 的 setup，读取的资源尚未被写入时推迟到写入方之后重试
+    void setupPasses();
+
+    // 标记输出没有被用到的 pass，填充 mCulledResources 并释放其中已创建的 RHI 对象
+    void cullPasses();
+
+    // 按读写声明拓扑排序填充 mExecutionOrder，有环时返回 false
+    bool sortPasses();
+
+    // 按执行顺序计算瞬态资源的生命周期并分配别名，填充 mAliasOwners
+    void aliasTransientResources();
+
+    // 计算各资源的描述哈希和图哈希，释放哈希与上次编译不同的资源的 RHI 对象，返回变化的资源数
+    qint32 releaseChangedResources();
+
     void createRhiResource(RGResource *resource);
 
     void releaseRhiResource(RGResource *resource);
 
+    // 按基本资源、render target、管线的顺序创建缺失的 RHI 对象，全部成功时返回 true
+    bool createRhiResources();
+
+    // 编译结果仍然有效、只有输出尺寸变化时，重建相对尺寸的资源
+    void applyOutputResize();
+
     // --- 所需状态 ---
     QRhi *mRhi;
     QSharedPointer<ResourceManager> mResourceManager;
     QSharedPointer<World> mWorld;
+    QSharedPointer<RenderScene> mRenderScene;
     QSize mOutputSize;
     QRhiRenderPassDescriptor *mSwapChainRpDesc;
 
@@ -82,11 +139,21 @@ private:
     QVector<QSharedPointer<RGPass> > mPasses;
     QHash<QString, QSharedPointer<RGResource> > mResources;
     QVector<RGPass *> mExecutionOrder;
+    QSet<QString> mExportedResources;
+    // 只被剔除的 pass 用到的资源
+    QSet<QString> mCulledResources;
+    // 别名资源名 -> 实际持有 RHI 对象的资源名
+    QHash<QString, QString> mAliasOwners;
+    // 上次编译时各资源的描述哈希，以及由执行顺序和全部描述得到的图哈希
+    QHash<QString, size_t> mResourceHashes;
+    size_t mGraphHash = 0;
 
     // --- 执行状态 ---
     QRhiCommandBuffer *mCommandBuffer = nullptr;
     QRhiSwapChain *mCurrentSwapChain = nullptr;
     bool mCompiled = false;
+    // setOutputSize 改变了相对尺寸资源的描述，等待 compile() 重建
+    bool mResizePending = false;
 };
 
 template<typename PassType, typename... Args>
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <QHash>
+#include <QVector>
+
+#include "ECSCore.h"
+
+/*!
+ * 组件类型的类型擦除信息，用于在 chunk 之间搬运组件
+ * @note 可平凡拷贝的组件（字符串和几何体都换成了句柄后，目前全部组件都是）按字节搬运，不调用构造/析构
+ * @note 空结构体（标签组件）的 size 记为 0，在 chunk 中不占空间，只体现在 Archetype 签名里
+ */
+struct ComponentTypeInfo {
+    ComponentTypeID id;
+    quint32 size;
+    quint32 alignment;
+    bool trivial;
+
+    // 在 dst 处以 src 移动构造，src 仍需由调用方析构
+    void (*moveConstruct)(void *dst, void *src);
+
+    // 在 dst 处以 src 拷贝构造，用于 prefab 实例化
+    void (*copyConstruct)(void *dst, const void *src);
+
+    void (*destroy)(void *ptr);
+
+    template<typename T>
+    static const ComponentTypeInfo &of() {
+        static const ComponentTypeInfo info{
+            getComponentTypeID<T>(),
+            std::is_empty_v<T> ? 0u : static_cast<quint32>(sizeof(T)),
+            alignof(T),
+            std::is_trivially_copyable_v<T>,
+            [](void *dst, void *src) { new(dst) T(std::move(*static_cast<T *>(src))); },
+            [](void *dst, const void *src) { new(dst) T(*static_cast<const T *>(src)); },
+            [](void *ptr) { static_cast<T *>(ptr)->~T(); }
+        };
+        return info;
+    }
+};
+
+/*!
+ * 一个固定大小的内存块，按 SoA 排布：[实体 ID 数组][组件列 0][组件列 1]...[列 0 变更 tick][列 1 变更 tick]...
+ */
+struct ArchetypeChunk {
+    struct Deleter {
+        void operator()(std::byte *ptr) const { ::operator delete(ptr, std::align_val_t{64}); }
+    };
+
+    std::unique_ptr<std::byte[], Deleter> memory;
+    qint32 count = 0;
+};
+
+/*!
+ * 组件签名相同的实体存放在同一个 Archetype 中
+ * 行(row)在 chunk 内紧密排列，除最后一个 chunk 外其余 chunk 都是满的；删除时用最后一行填补空洞
+ */
+class Archetype {
+public:
+    static constexpr qint32 ChunkBytes = 16 * 1024;
+
+    struct Location {
+        qint32 chunk = -1;
+        qint32 row = -1;
+    };
+
+    // types 必须按 ComponentTypeID 排好序且不重复
+    explicit Archetype(QVector<const ComponentTypeInfo *> types);
+
+    const QVector<ComponentTypeID> &signature() const { return mSignature; }
+    const QVector<const ComponentTypeInfo *> &types() const { return mTypes; }
+
+    qint32 columnIndex(ComponentTypeID typeId) const {
+        return typeId < static_cast<ComponentTypeID>(mColumnByType.size()) ? mColumnByType[typeId] : -1;
+    }
+
+    bool hasComponent(ComponentTypeID typeId) const { return columnIndex(typeId) >= 0; }
+
+    qint32 chunkCapacity() const { return mChunkCapacity; }
+    qint32 chunkCount() const { return static_cast<qint32>(mChunks.size()); }
+    qint32 chunkSize(qint32 chunk) const { return mChunks[chunk].count; }
+    qint32 entityCount() const { return mEntityCount; }
+
+    EntityID *entities(qint32 chunk) const {
+        return reinterpret_cast<EntityID *>(mChunks[chunk].memory.get());
+    }
+
+    void *columnData(qint32 chunk, qint32 column) const {
+        return mChunks[chunk].memory.get() + mColumnOffsets[column];
+    }
+
+    void *component(const Location &location, qint32 column) const {
+        return static_cast<std::byte *>(columnData(location.chunk, column)) +
+               static_cast<qsizetype>(location.row) * mTypes[column]->size;
+    }
+
+    // 列中每一行组件最后一次被写入时的 World 变更 tick
+    quint32 *changeTicks(qint32 chunk, qint32 column) const {
+        return reinterpret_cast<quint32 *>(mChunks[chunk].memory.get() + mTickOffsets[column]);
+    }
+
+    quint32 &changeTick(const Location &location, qint32 column) const {
+        return changeTicks(location.chunk, column)[location.row];
+    }
+
+    // 在末尾分配一行并写入实体 ID，组件内存未初始化，由调用方构造
+    Location allocateRow(EntityID entity);
+
+    // 把 src 处的组件移到 dst 并析构 src，可平凡拷贝的类型直接 memcpy
+    static void relocate(const ComponentTypeInfo &type, void *dst, void *src) {
+        if (type.trivial) {
+            std::memcpy(dst, src, type.size);
+        } else {
+            type.moveConstruct(dst, src);
+            type.destroy(src);
+        }
+    }
+
+    // 析构该行的全部组件
+    void destroyRow(const Location &location);
+
+    /**
+     * @brief 释放一行，该行的组件必须已被析构或移走。
+     * @return 被搬到空洞位置的原末尾实体，没有发生搬运时返回 INVALID_ENTITY。
+     */
+    EntityID releaseRow(const Location &location);
+
+    // 结构变化时的跳转缓存，避免重复查找目标 Archetype
+    QHash<ComponentTypeID, Archetype *> mAddEdges;
+    QHash<ComponentTypeID, Archetype *> mRemoveEdges;
+
+private:
+    QVector<const ComponentTypeInfo *> mTypes;
+    QVector<ComponentTypeID> mSignature;
+    // 以 ComponentTypeID 索引的列下标表，-1 表示不含该组件；签名已排序，长度为最大 ID + 1
+    QVector<qint32> mColumnByType;
+    QVector<qsizetype> mColumnOffsets;
+    QVector<qsizetype> mTickOffsets;
+    qint32 mChunkCapacity = 0;
+    qsizetype mChunkBytes = ChunkBytes;
+    qint32 mEntityCount = 0;
+    std::vector<ArchetypeChunk> mChunks;
+};
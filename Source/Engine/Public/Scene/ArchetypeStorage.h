@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "Scene/Archetype.h"
+
+/*!
+ * Archetype 存储模式：按组件签名把实体分组到 SoA chunk 中
+ * 多组件查询只需线性遍历签名匹配的 chunk，组件增删时实体在 Archetype 之间搬移
+ */
+class ArchetypeStorage {
+public:
+    struct EntityRecord {
+        Archetype *archetype = nullptr;
+        Archetype::Location location;
+    };
+
+    ~ArchetypeStorage();
+
+    template<typename T>
+    void insert(EntityID entity, T component, quint32 changeTick = 0);
+
+    /**
+     * @brief 把一批还没有任何组件的实体直接放进签名为 Ts 的 Archetype，每个实体拷贝一份 components。
+     *
+     * 目标 Archetype 只查找一次，实体不经过逐个组件的迁移。
+     */
+    template<typename... Ts>
+    void insertBatch(const QVector<EntityID> &entities, quint32 changeTick, const Ts &... components);
+
+    // 把 source 的整行组件复制给 targets，targets 必须还没有任何组件
+    void cloneEntity(EntityID source, const QVector<EntityID> &targets, quint32 changeTick);
+
+    void remove(EntityID entity, ComponentTypeID typeId);
+
+    void removeEntity(EntityID entity);
+
+    bool has(EntityID entity, ComponentTypeID typeId) const {
+        const EntityRecord *record = findRecord(entity);
+        return record && record->archetype && record->archetype->hasComponent(typeId);
+    }
+
+    template<typename T>
+    T *get(EntityID entity) const {
+        const EntityRecord *record = findRecord(entity);
+        if (!record || !record->archetype) return nullptr;
+        const qint32 column = record->archetype->columnIndex(getComponentTypeID<T>());
+        if (column < 0) return nullptr;
+        return static_cast<T *>(record->archetype->component(record->location, column));
+    }
+
+    // 记录组件被写入，返回组件指针；实体没有该组件时返回 nullptr
+    template<typename T>
+    T *markChanged(EntityID entity, quint32 changeTick) {
+        const EntityRecord *record = findRecord(entity);
+        if (!record || !record->archetype) return nullptr;
+        const qint32 column = record->archetype->columnIndex(getComponentTypeID<T>());
+        if (column < 0) return nullptr;
+        record->archetype->changeTick(record->location, column) = changeTick;
+        return static_cast<T *>(record->archetype->component(record->location, column));
+    }
+
+    // 收集 typeId 组件的变更 tick 晚于 sinceTick 的实体
+    void collectChangedSince(ComponentTypeID typeId, quint32 sinceTick, QVector<EntityID> &out) const;
+
+    /**
+     * @brief 遍历包含全部 Ts 的每个 chunk。
+     * @param fn 签名为 fn(qint32 count, const EntityID *entities, Ts *... columns)，列指针在 chunk 内连续
+     */
+    template<typename... Ts, typename Fn>
+    void forEachChunk(Fn &&fn) const;
+
+    const std::vector<std::unique_ptr<Archetype> > &archetypes() const { return mArchetypes; }
+
+private:
+    const EntityRecord *findRecord(EntityID entity) const {
+        const quint32 index = entityIndex(entity);
+        return index < static_cast<quint32>(mRecords.size()) ? &mRecords[index] : nullptr;
+    }
+
+    void reserveRecords(const QVector<EntityID> &entities) {
+        quint32 maxIndex = 0;
+        for (const EntityID entity: entities) {
+            maxIndex = qMax(maxIndex, entityIndex(entity));
+        }
+        if (maxIndex >= static_cast<quint32>(mRecords.size())) {
+            mRecords.resize(maxIndex + 1);
+        }
+    }
+
+    EntityRecord &record(EntityID entity) {
+        const quint32 index = entityIndex(entity);
+        if (index >= static_cast<quint32>(mRecords.size())) {
+            mRecords.resize(index + 1);
+        }
+        return mRecords[index];
+    }
+
+    Archetype *findOrCreateArchetype(QVector<const ComponentTypeInfo *> types);
+
+    Archetype *archetypeWith(Archetype *source, const ComponentTypeInfo &added);
+
+    Archetype *archetypeWithout(Archetype *source, ComponentTypeID removed);
+
+    // 把实体整行搬到 target，target 中多出来的列保持未初始化，返回新位置
+    Archetype::Location moveEntity(EntityID entity, EntityRecord &record, Archetype *target);
+
+    // 以实体槽位下标直接索引，查找实体所在的 Archetype 和行；句柄是否过期由 World 判断
+    QVector<EntityRecord> mRecords;
+    std::vector<std::unique_ptr<Archetype> > mArchetypes;
+};
+
+template<typename T>
+void ArchetypeStorage::insert(EntityID entity, T component, quint32 changeTick) {
+    const ComponentTypeInfo &info = ComponentTypeInfo::of<T>();
+    EntityRecord &entityRecord = record(entity);
+
+    if (entityRecord.archetype) {
+        const qint32 column = entityRecord.archetype->columnIndex(info.id);
+        if (column >= 0) {
+            *static_cast<T *>(entityRecord.archetype->component(entityRecord.location, column)) = std::move(component);
+            entityRecord.archetype->changeTick(entityRecord.location, column) = changeTick;
+            return;
+        }
+    }
+
+    Archetype *target = archetypeWith(entityRecord.archetype, info);
+    const Archetype::Location location = moveEntity(entity, entityRecord, target);
+    const qint32 column = target->columnIndex(info.id);
+    new(target->component(location, column)) T(std::move(component));
+    target->changeTick(location, column) = changeTick;
+}
+
+template<typename... Ts>
+void ArchetypeStorage::insertBatch(const QVector<EntityID> &entities, quint32 changeTick, const Ts &... components) {
+    Archetype *target = findOrCreateArchetype({&ComponentTypeInfo::of<Ts>()...});
+    const std::array<qint32, sizeof...(Ts)> columns{target->columnIndex(getComponentTypeID<Ts>())...};
+    reserveRecords(entities);
+
+    for (const EntityID entity: entities) {
+        const Archetype::Location location = target->allocateRow(entity);
+        mRecords[entityIndex(entity)] = {target, location};
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((new(target->component(location, columns[I])) Ts(components),
+              target->changeTick(location, columns[I]) = changeTick), ...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+}
+
+template<typename... Ts, typename Fn>
+void ArchetypeStorage::forEachChunk(Fn &&fn) const {
+    const std::array<ComponentTypeID, sizeof...(Ts)> required{getComponentTypeID<Ts>()...};
+    for (const auto &archetype: mArchetypes) {
+        if (archetype->entityCount() == 0) continue;
+        const bool matches = std::all_of(required.begin(), required.end(), [&archetype](const ComponentTypeID &id) {
+            return archetype->hasComponent(id);
+        });
+        if (!matches) continue;
+
+        // 列下标每个 Archetype 只解析一次
+        std::array<qint32, sizeof...(Ts)> columns;
+        for (size_t i = 0; i < required.size(); ++i) {
+            columns[i] = archetype->columnIndex(required[i]);
+        }
+        for (qint32 chunk = 0; chunk < archetype->chunkCount(); ++chunk) {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                fn(archetype->chunkSize(chunk), static_cast<const EntityID *>(archetype->entities(chunk)),
+                   static_cast<Ts *>(archetype->columnData(chunk, columns[I]))...);
+            }(std::index_sequence_for<Ts...>{});
+        }
+    }
+}
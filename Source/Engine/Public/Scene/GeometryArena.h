@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QMultiHash>
+#include <QMutex>
+#include <QVector>
+
+#include "CommonRender.h"
+
+// GeometryArena 中一段顶点/索引数据的句柄，0 表示没有 CPU 几何体
+struct GeometryHandle {
+    quint32 id = 0;
+
+    bool isValid() const { return id != 0; }
+
+    friend bool operator==(GeometryHandle a, GeometryHandle b) { return a.id == b.id; }
+    friend bool operator!=(GeometryHandle a, GeometryHandle b) { return a.id != b.id; }
+};
+
+/*!
+ * 导入模型的 CPU 几何体存放在两个连续数组里，MeshComponent 只保存句柄
+ * 组件的拷贝、交换删除和扩容不再触碰顶点数据；只有场景保存和重新上传时按句柄取出
+ * @note 只追加不回收，但内容相同的几何体共享同一个句柄：重复打开同一个场景或重复导入同一个模型不会再占一份空间
+ */
+class GeometryArena {
+public:
+    static GeometryArena *getInstance();
+
+    // vertices 为空时返回无效句柄；已有内容完全相同的几何体时返回它的句柄
+    GeometryHandle allocate(const QVector<VertexData> &vertices, const QVector<quint16> &indices);
+
+    QVector<VertexData> vertices(GeometryHandle handle) const;
+
+    QVector<quint16> indices(GeometryHandle handle) const;
+
+private:
+    struct Range {
+        qsizetype firstVertex = 0;
+        qsizetype vertexCount = 0;
+        qsizetype firstIndex = 0;
+        qsizetype indexCount = 0;
+    };
+
+    mutable QMutex mMutex;
+    QVector<VertexData> mVertices;
+    QVector<quint16> mIndices;
+    // 以 id - 1 索引
+    QVector<Range> mRanges;
+    // 顶点和索引内容的哈希 -> 句柄 id，哈希相同时再逐字节比较
+    QMultiHash<size_t, quint32> mIdsByContent;
+};
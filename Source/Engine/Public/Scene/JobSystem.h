@@ -0,0 +1,30 @@
+#pragma once
+
+#include <functional>
+#include <QThreadPool>
+
+/*!
+ * 数据并行任务池：把 [0, count) 切成连续的块，按工作线程预先分段，空闲线程从其他线程的分段尾部窃取
+ * @note 调用线程本身也参与执行；线程池没有空闲线程时（例如嵌套调用）由调用线程独自完成，不会死锁
+ */
+class JobSystem {
+public:
+    static JobSystem *getInstance();
+
+    JobSystem();
+
+    ~JobSystem();
+
+    /**
+     * @brief 并行执行 fn(begin, end)，每次调用处理不超过 grainSize 个元素。
+     *
+     * 阻塞直到所有块完成。count 不超过一个 grain 时直接在调用线程执行。
+     */
+    void parallelFor(qint32 count, qint32 grainSize, const std::function<void(qint32 begin, qint32 end)> &fn);
+
+    // 参与执行的线程数（含调用线程）
+    qint32 concurrency() const { return mPool.maxThreadCount() + 1; }
+
+private:
+    QThreadPool mPool;
+};
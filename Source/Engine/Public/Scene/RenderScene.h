@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QSharedPointer>
+#include <QVector>
+#include <QVector3D>
+
+#include "CommonRender.h"
+#include "ECSCore.h"
+#include "Component/MaterialComponent.h"
+
+class World;
+
+// 一个可绘制实体在渲染端的副本，实例数据已经按 UBO 布局写好
+struct RenderInstanceProxy {
+    EntityID entity = INVALID_ENTITY;
+    InternedString meshId;
+    MaterialComponent material;
+    InstanceUniformBlock instance;
+    InstanceNormalUniformBlock normal;
+};
+
+struct RenderCameraProxy {
+    EntityID entity = INVALID_ENTITY;
+    QVector3D position;
+    QVector3D forward = {0.0f, 0.0f, -1.0f};
+    QVector3D up = {0.0f, 1.0f, 0.0f};
+    float fov = 90.0f;
+    float nearPlane = 0.1f;
+    float farPlane = 1000.0f;
+
+    bool isValid() const { return entity != INVALID_ENTITY; }
+};
+
+// 渲染一帧所需的全部场景数据，渲染端只读它，不访问 World
+struct RenderSceneFrame {
+    // 只包含可见且 mesh/material/transform 齐全的实体
+    QVector<RenderInstanceProxy> instances;
+    QHash<EntityID, qint32> instanceIndexByEntity;
+    RenderCameraProxy camera;
+    LightingUniformBlock lighting;
+
+    const RenderInstanceProxy *findInstance(EntityID entity) const {
+        const qint32 index = instanceIndexByEntity.value(entity, -1);
+        return index >= 0 ? &instances[index] : nullptr;
+    }
+};
+
+// 渲染端自上次读取以来需要处理的实体
+struct RenderSceneChanges {
+    // 为 true 时变化列表为空，渲染端需要按 instances 全量重建
+    bool reset = false;
+    // 增删，或 mesh、material、可见性发生变化
+    QVector<EntityID> drawChanged;
+    // 只有实例矩阵发生变化；两个列表内各自没有重复实体，渲染端可以按实体并行写入
+    QVector<EntityID> transformChanged;
+};
+
+/*!
+ * 双缓冲的渲染场景：模拟端把 World 中与渲染有关的数据（实例矩阵、mesh/material、相机、灯光）写进后台帧，
+ * 渲染端只读前台帧，两者可以在不同线程上重叠执行
+ * publish 只重写本次和上一次发布中变化过的实体（后台帧落后两次发布），交换本身是 O(1)
+ * @note publish 与修改 World 的代码在同一线程调用；acquireFrame/releaseFrame 在渲染线程调用，持有期间 publish 的交换会等待
+ */
+class RenderScene {
+public:
+    explicit RenderScene(QSharedPointer<World> world);
+
+    ~RenderScene();
+
+    RenderScene(const RenderScene &) = delete;
+
+    RenderScene &operator=(const RenderScene &) = delete;
+
+    // 收集上次发布以来的变化，写入后台帧并与前台帧交换
+    void publish();
+
+    /**
+     * @brief 锁定前台帧，并取走自上次读取以来累积的变化。
+     *
+     * 读取结束后必须调用 releaseFrame。
+     */
+    const RenderSceneFrame &acquireFrame(RenderSceneChanges &changes);
+
+    void releaseFrame();
+
+private:
+    // 按实体当前的组件新增、更新或删除它的实例副本
+    void syncInstance(RenderSceneFrame &frame, EntityID entity);
+
+    void syncTransform(RenderSceneFrame &frame, EntityID entity);
+
+    void removeInstance(RenderSceneFrame &frame, EntityID entity);
+
+    void syncCameraAndLights(RenderSceneFrame &frame);
+
+    // 单例指定的相机优先，其次是带 ActiveCameraTag 的相机，最后退回任意一个相机
+    void findActiveCamera();
+
+    QSharedPointer<World> mWorld;
+    // World::ObserverID
+    QVector<quint32> mObserverIds;
+    quint32 mLastTick = 0;
+    EntityID mActiveCamera = INVALID_ENTITY;
+
+    std::array<RenderSceneFrame, 2> mFrames;
+    // 只有 publish 修改，publish 所在线程读取时不需要加锁
+    qint32 mFrontIndex = 0;
+
+    // 观察者记下的结构变化，下次 publish 时处理
+    QSet<EntityID> mStructureDirty;
+    // 上一次发布中变化的实体，后台帧还没有应用它们
+    QSet<EntityID> mPreviousDrawDirty;
+    QVector<EntityID> mPreviousTransformDirty;
+
+    // 保护 mFrontIndex 的交换和 mPendingChanges
+    QMutex mFrameMutex;
+    RenderSceneChanges mPendingChanges;
+    // mPendingChanges 两个列表中已有的实体，渲染端跳过若干次读取时合并去重
+    QSet<EntityID> mPendingDrawSet;
+    QSet<EntityID> mPendingTransformSet;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QHash>
+#include <QVector>
+#include <QVector3D>
+
+#include "ECSCore.h"
+
+/*!
+ * 按实体位置划分的均匀空间哈希网格，只记录点，不记录包围盒
+ * 每个非空格子保存一段连续的 (实体, 位置) 数组，查询只访问与查询范围相交的格子
+ * 格子边长与常用查询半径相当时，一次查询的代价与结果数量成正比
+ * @note 格子坐标限制在 ±2^20 以内，超出范围的位置落在边界格子里，查询结果仍然正确，只是变慢
+ */
+class SpatialHashGrid {
+public:
+    explicit SpatialHashGrid(float cellSize = 4.0f);
+
+    float cellSize() const { return mCellSize; }
+
+    qint32 size() const { return mCount; }
+
+    void clear();
+
+    // 插入实体，已存在时更新位置；同一格子内移动只改写位置
+    void insertOrUpdate(EntityID entity, const QVector3D &position);
+
+    void remove(EntityID entity);
+
+    bool contains(EntityID entity) const;
+
+    // 结果追加到 out，不清空，顺序不确定
+    void queryRadius(const QVector3D &center, float radius, QVector<EntityID> &out) const;
+
+    // 包含边界上的点
+    void queryAabb(const QVector3D &min, const QVector3D &max, QVector<EntityID> &out) const;
+
+    template<typename Func>
+    void forEachEntity(Func &&func) const {
+        for (const QVector<Entry> &cell: mCells) {
+            for (const Entry &entry: cell) {
+                func(entry.entity, entry.position);
+            }
+        }
+    }
+
+private:
+    using CellKey = quint64;
+
+    struct Entry {
+        EntityID entity;
+        QVector3D position;
+    };
+
+    // 实体所在的格子和格子内下标，用于 O(1) 交换删除
+    struct Slot {
+        EntityID entity = INVALID_ENTITY;
+        CellKey cell = 0;
+        qint32 index = -1;
+    };
+
+    qint32 cellCoord(float value) const;
+
+    CellKey cellKeyOf(const QVector3D &position) const;
+
+    static CellKey packCell(qint32 x, qint32 y, qint32 z);
+
+    void removeFromCell(const Slot &slot);
+
+    template<typename Predicate>
+    void queryCells(const QVector3D &min, const QVector3D &max, Predicate &&inside, QVector<EntityID> &out) const;
+
+    float mCellSize;
+    float mInvCellSize;
+    QHash<CellKey, QVector<Entry> > mCells;
+    // 以 entityIndex 索引
+    QVector<Slot> mSlots;
+    qint32 mCount = 0;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+/*!
+ * 进程内的字符串驻留表：相同内容的字符串只保存一份，用 32 位 id 引用
+ * id 0 固定表示空字符串；驻留的字符串在进程结束前不会释放，resolve 返回的引用一直有效
+ * @note intern 加锁；resolve 不加锁，按 id 直接定位到分块数组中的元素，可以在任意线程并发调用
+ */
+class StringTable {
+public:
+    static StringTable *getInstance();
+
+    StringTable();
+
+    ~StringTable();
+
+    quint32 intern(const QString &value);
+
+    const QString &resolve(quint32 id) const;
+
+    // 已驻留的字符串数量（含空字符串）
+    quint32 size() const { return mCount.load(std::memory_order_acquire); }
+
+private:
+    static constexpr quint32 ChunkShift = 10;
+    static constexpr quint32 ChunkSize = 1u << ChunkShift;
+    static constexpr quint32 MaxChunks = 4096;
+
+    QMutex mMutex;
+    QHash<QString, quint32> mIdByString;
+    // 分块一旦分配就不再移动，扩容时已发布的元素地址保持不变
+    std::array<std::atomic<QString *>, MaxChunks> mChunks{};
+    std::atomic<quint32> mCount{0};
+};
+
+/*!
+ * 驻留字符串的句柄，只有一个 id，可平凡拷贝，比较和哈希都是整数运算
+ * 可以从 QString 隐式构造，也可以隐式当作 const QString & 使用
+ */
+struct InternedString {
+    quint32 id = 0;
+
+    InternedString() = default;
+
+    InternedString(const QString &value) : id(StringTable::getInstance()->intern(value)) {
+    }
+
+    InternedString(const char *value) : InternedString(QString::fromUtf8(value)) {
+    }
+
+    const QString &toString() const { return StringTable::getInstance()->resolve(id); }
+
+    operator const QString &() const { return toString(); }
+
+    bool isEmpty() const { return id == 0; }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.id == b.id; }
+    friend bool operator!=(InternedString a, InternedString b) { return a.id != b.id; }
+
+    // 与 QString 比较时不驻留对方，避免两个方向的隐式转换产生二义性
+    friend bool operator==(InternedString a, const QString &b) { return a.toString() == b; }
+    friend bool operator==(const QString &a, InternedString b) { return a == b.toString(); }
+    friend bool operator!=(InternedString a, const QString &b) { return a.toString() != b; }
+    friend bool operator!=(const QString &a, InternedString b) { return a != b.toString(); }
+};
+
+inline size_t qHash(InternedString value, size_t seed = 0) {
+    return qHash(value.id, seed);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QThreadPool>
 #include <QVector>
 
 #include "Interface/ISystem.h"
@@ -7,15 +8,31 @@
 
 class World;
 
+/*!
+ * 系统调度：根据 ISystem::access() 声明的读写集合建立依赖 DAG，
+ * 同一层内互不冲突的系统在线程池上并行执行，有冲突的系统保持注册顺序串行执行
+ */
 class SystemManager {
 public:
+    SystemManager();
+
     template<typename T, typename... Args>
     T *addSystem(Args &&... args);
 
     void updateAll(World *world, float deltaTime);
 
 private:
+    void buildSchedule();
+
     QVector<QSharedPointer<ISystem> > mSystems;
+
+    // 按依赖层级划分的执行批次，同一批次内的系统互不冲突
+    QVector<QVector<ISystem *> > mWaves;
+    bool mScheduleDirty = true;
+    // 调度变化后的第一帧串行执行，让系统内部的 group 注册等一次性结构操作在单线程完成
+    bool mWarmedUp = false;
+
+    QThreadPool mThreadPool;
 };
 
 template<typename T, typename... Args>
@@ -24,5 +41,6 @@ T *SystemManager::addSystem(Args &&... args) {
     auto system = QSharedPointer<T>::create(std::forward<Args>(args)...);
     T *ptr = system.get();
     mSystems.emplace_back(std::move(system));
+    mScheduleDirty = true;
     return ptr;
 }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QVector>
+
+struct TransformComponent;
+
+/*!
+ * 按分量拆开的 TRS 数组（位置/四元数/缩放各自连续），供批量合成矩阵
+ * 合成内核一次处理 4 个（SSE2/NEON）或 8 个（AVX2）变换，直接写出列主序 4x4 矩阵，不经过 QMatrix4x4 的 translate/rotate/scale
+ * @note 内核在编译期选择：定义了 __AVX2__ 时用 AVX2（Engine 的 QTR_ENABLE_AVX2 选项），否则 x86 用 SSE2，ARM 用 NEON，其余平台退回标量
+ */
+class TransformSoA {
+public:
+    qint32 size() const { return mPositionX.size(); }
+
+    void clear();
+
+    void reserve(qint32 count);
+
+    void append(const TransformComponent &transform);
+
+    void set(qint32 index, const TransformComponent &transform);
+
+    /**
+     * @brief 把 [begin, end) 的变换合成为 T * R * S 矩阵。
+     *
+     * 第 i 个矩阵以 16 个 float（列主序，与 QMatrix4x4::constData / QGenericMatrix 相同）写到 output + (i - begin) * stride 字节处，
+     * stride 可以是实例数据结构体的大小，矩阵直接写进上传缓冲区。四元数需已归一化，与 QMatrix4x4::rotate 的约定相同。
+     */
+    void composeMatrices(qint32 begin, qint32 end, void *output, qsizetype stride) const;
+
+    // 当前编译选用的内核："avx2"、"sse2"、"neon" 或 "scalar"
+    static const char *kernelName();
+
+private:
+    QVector<float> mPositionX;
+    QVector<float> mPositionY;
+    QVector<float> mPositionZ;
+    QVector<float> mRotationX;
+    QVector<float> mRotationY;
+    QVector<float> mRotationZ;
+    QVector<float> mRotationW;
+    QVector<float> mScaleX;
+    QVector<float> mScaleY;
+    QVector<float> mScaleZ;
+};
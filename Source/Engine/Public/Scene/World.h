@@ -1,44 +1,219 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <set>
+#include <tuple>
+
 #include "Component/ComponentArray.h"
 #include "Resources/ShaderBundle.h"
+#include "Scene/ArchetypeStorage.h"
+#include "Scene/JobSystem.h"
+
+class WorldCommandBuffer;
 
 class World {
+    // 快照需要原样保存和恢复实体槽位（下标 + 代数）
+    friend class WorldSnapshot;
+
+public:
+    /*!
+     * 组件存储模式
+     * SparseSet: 每种组件一个 ComponentArray，增删组件代价最低
+     * Archetype: 相同组件签名的实体放在同一组 SoA chunk 中，多组件查询按 chunk 线性遍历
+     */
+    enum class StorageMode {
+        SparseSet,
+        Archetype
+    };
+
+    explicit World(StorageMode mode = StorageMode::SparseSet);
+
+    ~World();
+
+    StorageMode storageMode() const { return mStorageMode; }
+
+    // 延迟执行的结构变化命令，工作线程和遍历中的代码通过它增删实体/组件，由 SystemManager 在同步点回放
+    WorldCommandBuffer &commands() { return *mCommandBuffer; }
+
 private:
     // --- ECS ---
     template<typename T>
-    QSharedPointer<ComponentArray<T> > getComponentArray() {
-        auto typeId = std::type_index(typeid(T));
-        if (!mComponentArrays.contains(typeId)) {
-            QSharedPointer<ComponentArray<T> > newArray = QSharedPointer<ComponentArray<T> >::create();
-            mComponentArrays.insert(typeId, newArray);
+    ComponentArray<T> *getComponentArray() {
+        const ComponentTypeID typeId = getComponentTypeID<T>();
+        if (typeId >= static_cast<ComponentTypeID>(mComponentArrays.size())) {
+            mComponentArrays.resize(typeId + 1);
         }
-        return qSharedPointerCast<ComponentArray<T> >(mComponentArrays[typeId]);
+        auto &array = mComponentArrays[typeId];
+        if (!array) {
+            array = QSharedPointer<ComponentArray<T> >::create();
+        }
+        return static_cast<ComponentArray<T> *>(array.get());
     }
 
     template<typename T>
-    QSharedPointer<const ComponentArray<T>> getComponentArray() const {
-        const auto typeId = std::type_index(typeid(T));
-        if (!mComponentArrays.contains(typeId)) {
+    const ComponentArray<T> *getComponentArray() const {
+        const ComponentTypeID typeId = getComponentTypeID<T>();
+        if (typeId >= static_cast<ComponentTypeID>(mComponentArrays.size())) {
             return nullptr;
         }
-        return qSharedPointerCast<const ComponentArray<T>>(mComponentArrays[typeId]);
+        return static_cast<const ComponentArray<T> *>(mComponentArrays[typeId].get());
+    }
+
+    // 与 getComponentArray 相同但不会创建数组，可在并行遍历中使用
+    template<typename T>
+    ComponentArray<T> *findComponentArray() {
+        return const_cast<ComponentArray<T> *>(std::as_const(*this).getComponentArray<T>());
     }
 
 public:
+    /**
+     * @brief 创建实体，优先复用已销毁实体的槽位。
+     * @return 槽位下标 + 当前代数组成的句柄
+     */
     EntityID createEntity() {
-        EntityID id = mNextEntityId++;
-        mEntityComponentTypes[id] = {};
-        return id;
+        quint32 index;
+        if (!mFreeIndices.isEmpty()) {
+            index = mFreeIndices.takeLast();
+        } else {
+            index = static_cast<quint32>(mEntitySlots.size());
+            mEntitySlots.append(EntitySlot{});
+        }
+        EntitySlot &slot = mEntitySlots[index];
+        slot.alive = true;
+        return makeEntity(index, slot.generation);
     }
 
     void destroyEntity(EntityID entity) {
-        if (mEntityComponentTypes.contains(entity)) {
-            for (const auto &typeId: mEntityComponentTypes[entity]) {
-                if (mComponentArrays.count(typeId)) {
-                    mComponentArrays[typeId]->removeEntity(entity);
+        if (!isAlive(entity)) return;
+        // 组件还在时通知 onRemove，观察者可以读到被销毁前的数据
+        for (const ComponentTypeID typeId: QVector<ComponentTypeID>(mEntitySlots[entityIndex(entity)].componentTypes)) {
+            if (hasObservers(ObserverKind::Remove, typeId)) {
+                notifyObservers(ObserverKind::Remove, typeId, entity);
+            }
+        }
+        EntitySlot &slot = mEntitySlots[entityIndex(entity)];
+        removeFromGroups(entity, slot.componentTypes);
+        if (mStorageMode == StorageMode::Archetype) {
+            mArchetypeStorage.removeEntity(entity);
+        } else {
+            for (const auto &typeId: std::as_const(slot.componentTypes)) {
+                if (const auto array = mComponentArrays.value(typeId)) {
+                    array->removeEntity(entity);
                 }
             }
-            mEntityComponentTypes.remove(entity);
+        }
+        if (!slot.componentTypes.isEmpty()) {
+            mStructureChangeTick = changeTick();
+        }
+        slot.componentTypes.clear();
+        slot.alive = false;
+        // 代数递增使所有旧句柄失效，槽位进入空闲列表等待复用
+        if (++slot.generation == PENDING_ENTITY_GENERATION) {
+            slot.generation = 0;
+        }
+        mFreeIndices.append(entityIndex(entity));
+    }
+
+    // O(1) 判断句柄是否仍指向存活实体，不做哈希查找
+    bool isAlive(EntityID entity) const {
+        const quint32 index = entityIndex(entity);
+        if (index == 0 || index >= static_cast<quint32>(mEntitySlots.size())) return false;
+        const EntitySlot &slot = mEntitySlots[index];
+        return slot.alive && slot.generation == entityGeneration(entity);
+    }
+
+    qint32 entityCount() const { return mEntitySlots.size() - 1 - mFreeIndices.size(); }
+
+    // 实体槽位总数（含空闲槽位），按 entityIndex 索引的外部数组以它为大小
+    qint32 entityCapacity() const { return mEntitySlots.size(); }
+
+    /**
+     * @brief 一次性创建 count 个实体，每个实体带有 components 的一份拷贝。
+     *
+     * 实体槽位、组件存储和 group 成员表都只扩容一次；Archetype 模式下直接写入目标签名的 chunk，
+     * 不会像逐个 addComponent 那样在中间 Archetype 之间反复搬移。
+     */
+    template<typename... Ts>
+    QVector<EntityID> createEntities(qint32 count, const Ts &... components) {
+        static_assert(sizeof...(Ts) > 0, "createEntities needs at least one component");
+        static_assert((std::is_base_of_v<Component, Ts> && ...), "T must inherit from Component (for concept check)");
+        const QVector<ComponentTypeID> types{getComponentTypeID<Ts>()...};
+        Q_ASSERT_X(std::set<ComponentTypeID>(types.begin(), types.end()).size() == types.size(),
+                   "World::createEntities", "duplicate component type");
+        if (count <= 0) return {};
+
+        const QVector<EntityID> entities = allocateEntities(count, types);
+        const quint32 tick = changeTick();
+        if (mStorageMode == StorageMode::Archetype) {
+            mArchetypeStorage.insertBatch<Ts...>(entities, tick, components...);
+        } else {
+            (getComponentArray<Ts>()->insertBatch(entities, components, tick), ...);
+        }
+        onEntitiesCreated(entities, types, tick);
+        return entities;
+    }
+
+    // 创建一个带有给定组件的实体，组件一次放到位，避免逐个 addComponent 的多次迁移
+    template<typename T, typename... Ts>
+    EntityID createEntity(const T &component, const Ts &... components) {
+        return createEntities(1, component, components...).constFirst();
+    }
+
+    /**
+     * @brief 以 prefab 实体为模板实例化 count 个拷贝，复制它当前拥有的全部组件。
+     * @note prefab 本身仍是普通实体，不希望它被渲染时可以把 RenderableComponent 设为不可见
+     */
+    QVector<EntityID> instantiate(EntityID prefab, qint32 count);
+
+    // 销毁全部实体并移除单例组件，已注册的 group 保留但成员清空
+    void clear();
+
+    /**
+     * @brief 为一批实体一次性添加各不相同的 T 组件，entities[i] 对应 components[i]。
+     *
+     * 实体必须存活且还没有 T。SparseSet 模式下数组为空时直接接管 components 的存储，不再拷贝。
+     */
+    template<typename T>
+    void insertComponents(const QVector<EntityID> &entities, QVector<T> components) {
+        Q_ASSERT(entities.size() == components.size());
+        const quint32 tick = changeTick();
+        if (mStorageMode == StorageMode::Archetype) {
+            for (qint32 i = 0; i < entities.size(); ++i) {
+                mArchetypeStorage.insert<T>(entities[i], std::move(components[i]), tick);
+            }
+        } else {
+            getComponentArray<T>()->insertRange(entities, std::move(components), tick);
+        }
+
+        const ComponentTypeID typeId = getComponentTypeID<T>();
+        for (const EntityID entity: entities) {
+            mEntitySlots[entityIndex(entity)].componentTypes.append(typeId);
+            addToGroups(entity, typeId);
+        }
+        markTypeChanged(typeId, tick);
+        mStructureChangeTick = tick;
+        if (hasObservers(ObserverKind::Add, typeId)) {
+            for (const EntityID entity: entities) {
+                notifyObservers(ObserverKind::Add, typeId, entity);
+            }
+        }
+    }
+
+    /**
+     * @brief 以连续内存块的形式只读遍历全部 T 组件，fn(qint32 count, const EntityID *entities, const T *components)。
+     *
+     * SparseSet 模式只有一个块，Archetype 模式每个 chunk 一个块。
+     */
+    template<typename T, typename Fn>
+    void forEachComponentBlock(Fn &&fn) const {
+        if (mStorageMode == StorageMode::Archetype) {
+            mArchetypeStorage.forEachChunk<T>([&fn](qint32 count, const EntityID *entities, T *components) {
+                fn(count, entities, static_cast<const T *>(components));
+            });
+        } else if (const ComponentArray<T> *array = getComponentArray<T>(); array && array->size() > 0) {
+            fn(array->size(), array->entities().constData(), array->data().constData());
         }
     }
 
@@ -47,35 +222,123 @@ public:
         static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component (for concept check)");
         static_assert(std::is_trivial_v<T> || std::is_standard_layout_v<T>,
                       "Component should be POD-like for performance");
+        if (!isAlive(entity)) return;
 
-        getComponentArray<T>()->insert(entity, component);
+        const quint32 tick = changeTick();
+        if (mStorageMode == StorageMode::Archetype) {
+            mArchetypeStorage.insert<T>(entity, std::move(component), tick);
+        } else {
+            getComponentArray<T>()->insert(entity, std::move(component), tick);
+        }
 
-        if (mEntityComponentTypes.contains(entity)) {
-            auto &types = mEntityComponentTypes[entity];
-            auto typeId = std::type_index(typeid(T));
-            if (types.indexOf(typeId) == -1) {
-                types.push_back(typeId);
+        auto &types = mEntitySlots[entityIndex(entity)].componentTypes;
+        const ComponentTypeID typeId = getComponentTypeID<T>();
+        markTypeChanged(typeId, tick);
+        if (types.indexOf(typeId) == -1) {
+            types.push_back(typeId);
+            addToGroups(entity, typeId);
+            mStructureChangeTick = tick;
+            if (hasObservers(ObserverKind::Add, typeId)) {
+                notifyObservers(ObserverKind::Add, typeId, entity);
             }
         }
     }
 
     template<typename T>
     void removeComponent(EntityID entity) {
-        getComponentArray<T>()->remove(entity);
-        if (mEntityComponentTypes.count(entity)) {
-            auto &types = mEntityComponentTypes[entity];
-            auto typeId = std::type_index(typeid(T));
-            types.removeAll(typeId);
+        if (!isAlive(entity)) return;
+        const ComponentTypeID typeId = getComponentTypeID<T>();
+        const bool present = mEntitySlots[entityIndex(entity)].componentTypes.contains(typeId);
+        if (present && hasObservers(ObserverKind::Remove, typeId)) {
+            notifyObservers(ObserverKind::Remove, typeId, entity);
+        }
+        if (mStorageMode == StorageMode::Archetype) {
+            mArchetypeStorage.remove(entity, typeId);
+        } else {
+            getComponentArray<T>()->remove(entity);
+        }
+        if (present) {
+            mEntitySlots[entityIndex(entity)].componentTypes.removeAll(typeId);
+            removeFromGroups(entity, {typeId});
+            mStructureChangeTick = changeTick();
+        }
+    }
+
+    // --- 组件观察者 ---
+    // 回调时组件仍可通过 world 读取；回调里可以创建实体，但不要增删当前实体的组件
+    using ComponentObserver = std::function<void(World &, EntityID)>;
+    using ObserverID = quint32;
+
+    /*!
+     * 实体获得 T 时回调：addComponent、createEntities、instantiate、insertComponents（包括快照读取）
+     * @note 派生数据结构（场景树、渲染批次等）靠 onAdd/onRemove/onChange 增量维护，不必每帧重新扫描 World
+     */
+    template<typename T>
+    ObserverID onAdd(ComponentObserver callback) {
+        return addObserver(ObserverKind::Add, getComponentTypeID<T>(), std::move(callback));
+    }
+
+    // 实体失去 T 时回调：removeComponent、destroyEntity（包括 clear），在组件被移除之前调用
+    template<typename T>
+    ObserverID onRemove(ComponentObserver callback) {
+        return addObserver(ObserverKind::Remove, getComponentTypeID<T>(), std::move(callback));
+    }
+
+    /*!
+     * T 被写入时回调：getMutableComponent / markChanged / 对已有组件的 addComponent
+     * 写入点拿到的是指针，写入发生在返回之后，因此不在写入点立即回调，而是由 dispatchChangeObservers 按变更 tick 成批派发
+     * @note 同一帧内多次写入只回调一次；新增的组件也带有变更 tick，会在 onAdd 之后再收到一次 onChange
+     */
+    template<typename T>
+    ObserverID onChange(ComponentObserver callback) {
+        return addObserver(ObserverKind::Change, getComponentTypeID<T>(), std::move(callback));
+    }
+
+    void removeObserver(ObserverID id);
+
+    // 把上次派发以来被写入的组件派发给 onChange 观察者，每帧在系统更新之后调用一次
+    void dispatchChangeObservers();
+
+    /**
+     * @brief 以写入为目的获取组件，同时把组件标记为在当前 tick 发生了变化。
+     *
+     * getComponent 返回的指针也可以写，但写入不会被 changedSince 观察到；需要增量处理的组件都应经过这里。
+     */
+    template<typename T>
+    T *getMutableComponent(EntityID entity) {
+        if (!isAlive(entity)) return nullptr;
+        const quint32 tick = changeTick();
+        T *component = nullptr;
+        if (mStorageMode == StorageMode::Archetype) {
+            component = mArchetypeStorage.markChanged<T>(entity, tick);
+        } else if (auto *array = findComponentArray<T>()) {
+            component = array->markChanged(entity, tick);
+        }
+        if (component) {
+            // 组件已经存在，addComponent 时已为该类型分配了槽位；parallelEach 等会从多个线程同时写，不能扩容
+            std::atomic_ref<quint32>(mTypeChangeTicks[getComponentTypeID<T>()]).store(tick, std::memory_order_relaxed);
         }
+        return component;
+    }
+
+    // 通过 each 等途径原地修改组件后，手动标记变化
+    template<typename T>
+    void markChanged(EntityID entity) {
+        getMutableComponent<T>(entity);
     }
 
     template<typename T>
     T *getComponent(EntityID entity) {
-        return getComponentArray<T>()->get(entity);
+        // 不在这里创建组件数组：查询必须是只读的，才能被并行执行的系统同时调用
+        return const_cast<T *>(std::as_const(*this).getComponent<T>(entity));
     }
 
     template<typename T>
     const T *getComponent(EntityID entity) const {
+        if (!isAlive(entity)) return nullptr;
+        if (mStorageMode == StorageMode::Archetype) {
+            return mArchetypeStorage.get<T>(entity);
+        }
         auto array = getComponentArray<T>();
         return array ? array->get(entity) : nullptr;
     }
@@ -83,24 +346,177 @@ public:
 
     template<typename T>
     bool hasComponent(EntityID entity) const {
+        if (!isAlive(entity)) return false;
+        if (mStorageMode == StorageMode::Archetype) {
+            return mArchetypeStorage.has(entity, getComponentTypeID<T>());
+        }
         auto array = getComponentArray<T>();
         return array && array->hasEntity(entity);
     }
 
-    // --- View/Query System ---
+    // --- 单例组件 ---
+    /*!
+     * World 级别的唯一组件（当前相机、主方向光等），不属于任何实体，以 ComponentTypeID 直接索引，O(1) 读取
+     * @note 写入同样更新该类型的变更 tick，anyChangedSince<T> 可以观察到单例的替换
+     */
     template<typename T>
-    QPair<QVector<T> *, QVector<EntityID> > view() {
-        auto array = getComponentArray<T>();
-        QVector<EntityID> entities;
-        if (!array) return {nullptr, entities};
+    T &setSingleton(T value) {
+        static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component (for concept check)");
+        const ComponentTypeID typeId = getComponentTypeID<T>();
+        if (typeId >= static_cast<ComponentTypeID>(mSingletons.size())) {
+            mSingletons.resize(typeId + 1);
+        }
+        markTypeChanged(typeId, changeTick());
+        auto stored = std::make_shared<T>(std::move(value));
+        T &result = *stored;
+        mSingletons[typeId] = std::move(stored);
+        return result;
+    }
+
+    template<typename T>
+    T *singleton() {
+        return const_cast<T *>(std::as_const(*this).singleton<T>());
+    }
 
-        entities.reserve(array->size());
-        for (size_t i = 0; i < array->size(); ++i) {
-            entities.push_back(array->getEntity(i));
+    // 未设置时返回 nullptr
+    template<typename T>
+    const T *singleton() const {
+        const ComponentTypeID typeId = getComponentTypeID<T>();
+        if (typeId >= static_cast<ComponentTypeID>(mSingletons.size())) return nullptr;
+        return static_cast<const T *>(mSingletons[typeId].get());
+    }
+
+    template<typename T>
+    bool hasSingleton() const { return singleton<T>() != nullptr; }
+
+    template<typename T>
+    void removeSingleton() {
+        const ComponentTypeID typeId = getComponentTypeID<T>();
+        if (typeId >= static_cast<ComponentTypeID>(mSingletons.size()) || !mSingletons[typeId]) return;
+        mSingletons[typeId].reset();
+        markTypeChanged(typeId, changeTick());
+    }
+
+    // --- 变更追踪 ---
+    // 当前变更 tick，addComponent / getMutableComponent 以它标记组件
+    quint32 changeTick() const { return mChangeTick.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 推进变更 tick，返回推进前的值。
+     *
+     * 增量系统每次处理前调用并保存返回值，下一次用 changedSince<T>(保存值) 取得这段时间内被写过的组件。
+     * 推进之后的写入落在新的 tick 上，不会被漏掉。
+     */
+    quint32 advanceChangeTick() { return mChangeTick.fetch_add(1, std::memory_order_relaxed); }
+
+    // O(1) 判断 T 在 sinceTick 之后是否有任何写入（包括新增）
+    template<typename T>
+    bool anyChangedSince(quint32 sinceTick) const {
+        const ComponentTypeID typeId = getComponentTypeID<T>();
+        return typeChangeTick(typeId) > sinceTick;
+    }
+
+    // sinceTick 之后是否有实体增删组件或被销毁，这类变化不会出现在 changedSince 中
+    bool structureChangedSince(quint32 sinceTick) const { return mStructureChangeTick > sinceTick; }
+
+    /**
+     * @brief 返回 T 在 sinceTick 之后被写入或新增的实体。
+     *
+     * 线性扫描连续的 tick 数组，不访问组件本身；先用 anyChangedSince 排除完全静止的组件类型。
+     */
+    template<typename T>
+    QVector<EntityID> changedSince(quint32 sinceTick) const {
+        QVector<EntityID> changed;
+        if (!anyChangedSince<T>(sinceTick)) return changed;
+        collectChangedSince(getComponentTypeID<T>(), sinceTick, changed);
+        return changed;
+    }
+
+    /**
+     * @brief 对同时拥有全部 Ts 的实体调用 fn(EntityID, Ts &...)。
+     *
+     * 组件引用直接来自存储：Archetype 模式按 chunk 线性遍历，SparseSet 模式以第一个组件数组为驱动。
+     * 回调中不能直接增删组件或销毁实体，改用 commands() 录制；通过引用做的修改不会被变更追踪记录，需要时调用 markChanged。
+     */
+    template<typename... Ts, typename Fn>
+    void each(Fn &&fn) {
+        if (mStorageMode == StorageMode::Archetype) {
+            mArchetypeStorage.forEachChunk<Ts...>([&fn](qint32 count, const EntityID *entities, Ts *... columns) {
+                for (qint32 i = 0; i < count; ++i) {
+                    fn(entities[i], columns[i]...);
+                }
+            });
+            return;
+        }
+        eachSparse<Ts...>(std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief each 的并行版本：匹配的实体被切成不超过 grainSize 个的连续块，在 JobSystem 上并行调用 fn(EntityID, Ts &...)。
+     *
+     * 组件指针按块解析而不是逐实体 getComponent：Archetype 模式每个 chunk 切片解析一次列指针，
+     * SparseSet 模式以第一个组件的 dense 数组为驱动，块内直接按下标访问。
+     * fn 会在多个线程上同时执行，只能写入传入的组件，结构变化通过 commands() 录制。
+     */
+    template<typename... Ts, typename Fn>
+    void parallelEach(Fn &&fn, qint32 grainSize = 256) {
+        grainSize = qMax(1, grainSize);
+        if (mStorageMode == StorageMode::Archetype) {
+            // 切片不跨 chunk，每个切片内的组件列都是连续内存
+            struct Slice {
+                qint32 count;
+                const EntityID *entities;
+                std::tuple<Ts *...> columns;
+            };
+            QVector<Slice> slices;
+            mArchetypeStorage.forEachChunk<Ts...>([&](qint32 count, const EntityID *entities, Ts *... columns) {
+                for (qint32 begin = 0; begin < count; begin += grainSize) {
+                    slices.append({qMin(grainSize, count - begin), entities + begin, std::make_tuple(columns + begin...)});
+                }
+            });
+            JobSystem::getInstance()->parallelFor(slices.size(), 1, [&](qint32 begin, qint32 end) {
+                for (qint32 s = begin; s < end; ++s) {
+                    const Slice &slice = slices[s];
+                    std::apply([&](Ts *... columns) {
+                        for (qint32 i = 0; i < slice.count; ++i) {
+                            fn(slice.entities[i], columns[i]...);
+                        }
+                    }, slice.columns);
+                }
+            });
+            return;
+        }
+        parallelEachSparse<Ts...>(fn, grainSize);
+    }
+
+    /**
+     * @brief 持久化的多组件查询（group）。
+     *
+     * 首次调用时注册并填充匹配的实体集合，之后由 addComponent/removeComponent/destroyEntity 增量维护，
+     * 世界没有结构变化时重复查询只是一次查表。返回的数组在下一次结构变化前有效，遍历时不要增删组件。
+     */
+    template<typename... Ts>
+    const QVector<EntityID> &group() {
+        const quint32 key = Internal::QueryIDGenerator<Ts...>::get();
+        if (EntityGroup *cached = mGroupsByQuery.value(key, nullptr)) {
+            return cached->members.entities();
+        }
+
+        EntityGroup *group = findOrCreateGroup({getComponentTypeID<Ts>()...});
+        if (group->members.isEmpty()) {
+            for (EntityID entity: ViewIterator<Ts...>(this)) {
+                group->members.insert(entity);
+            }
         }
-        return {&(array->data()), entities};
+        if (key >= static_cast<quint32>(mGroupsByQuery.size())) {
+            mGroupsByQuery.resize(key + 1, nullptr);
+        }
+        mGroupsByQuery[key] = group;
+        return group->members.entities();
     }
 
+    // --- View/Query System ---
+    // 单类型的连续数据用 forEachComponentBlock 访问，view<T>() 与多类型一样返回 ViewIterator，两种存储模式都适用
     // More complex view (entities having ALL specified components)
     // This requires iterating one component array and checking for others.
     template<typename... ComponentTypes>
@@ -109,47 +525,39 @@ public:
         QVector<EntityID> mEntities;
         qint32 mCurrentIndex;
 
+        // 以第一个组件数组的 dense 实体序列为驱动，其余数组只解析一次，逐实体做 O(1) 的稀疏集查询
         template<typename First, typename... Rest>
         void filterEntities() {
-            auto array = mWorld->getComponentArray<First>();
-            if (!array) {
+            if (mWorld->mStorageMode == StorageMode::Archetype) {
+                mWorld->mArchetypeStorage.forEachChunk<First, Rest...>(
+                    [this](qint32 count, const EntityID *entities, auto *...) {
+                        for (qint32 i = 0; i < count; ++i) {
+                            mEntities.push_back(entities[i]);
+                        }
+                    });
+                return;
+            }
+
+            // 查询不创建组件数组，还没有出现过的类型直接得到空结果
+            const auto *array = mWorld->findComponentArray<First>();
+            const auto others = std::make_tuple(mWorld->findComponentArray<Rest>()...);
+            const bool allPresent = std::apply([](const auto *... arrays) { return ((arrays != nullptr) && ...); },
+                                               others);
+            if (!array || !allPresent) {
                 mEntities.clear();
                 return;
             }
 
-            if (mEntities.empty()) {
-                // 第一次：从组件数组中提取所有符合条件的实体
-                mEntities.reserve(array->size());
-                for (size_t i = 0; i < array->size(); ++i) {
-                    if (EntityID e = array->getEntity(i); e != INVALID_ENTITY && checkHasComponents<Rest...>(e)) {
-                        mEntities.push_back(e);
-                    }
-                }
-            } else {
-                // 从已有实体中过滤掉不符合条件的
-                QVector<EntityID> filtered;
-                filtered.reserve(mEntities.size());
-                for (const EntityID &e: std::as_const(mEntities)) {
-                    if (mWorld->hasComponent<First>(e) && checkHasComponents<Rest...>(e)) {
-                        filtered.append(e);
-                    }
+            mEntities.reserve(array->size());
+            for (const EntityID e: array->entities()) {
+                const bool hasAll = std::apply([e](const auto *... arrays) { return (arrays->hasEntity(e) && ...); },
+                                               others);
+                if (hasAll) {
+                    mEntities.push_back(e);
                 }
-                mEntities = std::move(filtered);
             }
         }
 
-        // Base case for template recursion
-        template<typename T>
-        bool checkHasComponents(EntityID e) const {
-            return mWorld->hasComponent<T>(e);
-        }
-
-        // Recursive step
-        template<typename First, typename Second, typename... Rest>
-        bool checkHasComponents(EntityID e) {
-            return mWorld->hasComponent<First>(e) && checkHasComponents<Second, Rest...>(e);
-        }
-
     public:
         ViewIterator(World *world) : mWorld(world), mCurrentIndex(0) {
             filterEntities<ComponentTypes...>();
@@ -188,9 +596,140 @@ public:
         return ViewIterator<ComponentTypes...>(this);
     }
 
+private:
+    template<typename First, typename... Rest, typename Fn>
+    void eachSparse(Fn &&fn) {
+        auto *array = findComponentArray<First>();
+        const auto others = std::make_tuple(findComponentArray<Rest>()...);
+        const bool allPresent = std::apply([](const auto *... arrays) { return ((arrays != nullptr) && ...); }, others);
+        if (!array || !allPresent) return;
+        for (qint32 i = 0; i < array->size(); ++i) {
+            const EntityID e = array->getEntity(i);
+            std::apply([&](auto *... arrays) {
+                if ((arrays->hasEntity(e) && ...)) {
+                    fn(e, array->at(i), *arrays->get(e)...);
+                }
+            }, others);
+        }
+    }
+
+    template<typename First, typename... Rest, typename Fn>
+    void parallelEachSparse(Fn &fn, qint32 grainSize) {
+        auto *array = findComponentArray<First>();
+        const auto others = std::make_tuple(findComponentArray<Rest>()...);
+        const bool allPresent = std::apply([](const auto *... arrays) { return ((arrays != nullptr) && ...); }, others);
+        if (!array || !allPresent) return;
+
+        const EntityID *entities = array->entities().constData();
+        JobSystem::getInstance()->parallelFor(array->size(), grainSize, [&](qint32 begin, qint32 end) {
+            for (qint32 i = begin; i < end; ++i) {
+                const EntityID e = entities[i];
+                std::apply([&](auto *... arrays) {
+                    if ((arrays->hasEntity(e) && ...)) {
+                        fn(e, array->at(i), *arrays->get(e)...);
+                    }
+                }, others);
+            }
+        });
+    }
+
+    struct EntityGroup {
+        QVector<ComponentTypeID> required;
+        EntitySparseSet members;
+    };
+
+    EntityGroup *findOrCreateGroup(QVector<ComponentTypeID> required);
+
+    bool entityMatches(EntityID entity, const QVector<ComponentTypeID> &required) const;
+
+    void addToGroups(EntityID entity, ComponentTypeID addedType);
+
+    void removeFromGroups(EntityID entity, const QVector<ComponentTypeID> &removedTypes);
+
+    // 批量分配存活的实体槽位，组件类型列表在这些槽位之间隐式共享
+    QVector<EntityID> allocateEntities(qint32 count, const QVector<ComponentTypeID> &types);
+
+    // 批量创建后更新 group 成员和变更 tick，并通知 onAdd 观察者
+    void onEntitiesCreated(const QVector<EntityID> &entities, const QVector<ComponentTypeID> &types, quint32 tick);
+
+    void collectChangedSince(ComponentTypeID typeId, quint32 sinceTick, QVector<EntityID> &out) const;
+
+    // 结构性修改时更新类型的变更 tick，可能扩容，只能在主线程调用
+    void markTypeChanged(ComponentTypeID typeId, quint32 tick) {
+        if (typeId >= static_cast<ComponentTypeID>(mTypeChangeTicks.size())) {
+            mTypeChangeTicks.resize(typeId + 1, 0);
+        }
+        std::atomic_ref<quint32>(mTypeChangeTicks[typeId]).store(tick, std::memory_order_relaxed);
+    }
+
+    quint32 typeChangeTick(ComponentTypeID typeId) const {
+        if (typeId >= static_cast<ComponentTypeID>(mTypeChangeTicks.size())) return 0;
+        // atomic_ref 不接受 const 对象，读取本身不会修改
+        return std::atomic_ref<quint32>(const_cast<quint32 &>(mTypeChangeTicks[typeId])).load(std::memory_order_relaxed);
+    }
+
+    enum ObserverKind : quint8 {
+        Add,
+        Remove,
+        Change,
+        ObserverKindCount
+    };
+
+    struct Observer {
+        ObserverID id;
+        ComponentObserver callback;
+    };
+
+    struct TypeObservers {
+        std::array<QVector<Observer>, ObserverKindCount> lists;
+        // 上次派发 onChange 时推进前的变更 tick
+        quint32 lastChangeDispatch = 0;
+    };
+
+    bool hasObservers(ObserverKind kind, ComponentTypeID typeId) const {
+        return typeId < static_cast<ComponentTypeID>(mObservers.size()) && !mObservers[typeId].lists[kind].isEmpty();
+    }
+
+    ObserverID addObserver(ObserverKind kind, ComponentTypeID typeId, ComponentObserver callback);
+
+    void notifyObservers(ObserverKind kind, ComponentTypeID typeId, EntityID entity);
+
+    std::vector<std::unique_ptr<EntityGroup> > mGroups;
+    // 以 ComponentTypeID 索引，组件参与的全部 group
+    QVector<QVector<EntityGroup *> > mGroupsByType;
+    // 以 Internal::QueryIDGenerator 分配的查询 ID 索引
+    QVector<EntityGroup *> mGroupsByQuery;
+
+    struct EntitySlot {
+        quint32 generation = 0;
+        bool alive = false;
+        QVector<ComponentTypeID> componentTypes;
+    };
+
+    // 以槽位下标索引，下标 0 保留给 INVALID_ENTITY
+    QVector<EntitySlot> mEntitySlots{EntitySlot{}};
+    QVector<quint32> mFreeIndices;
+
+    std::unique_ptr<WorldCommandBuffer> mCommandBuffer;
+
+    // 变更 tick 从 1 开始，0 表示“从未见过”，第一次 changedSince(0) 会返回全部组件
+    std::atomic<quint32> mChangeTick{1};
+    quint32 mStructureChangeTick = 0;
+    // 以 ComponentTypeID 索引，每种组件最后一次写入的 tick；元素经 std::atomic_ref 以 relaxed 读写，
+    // 只有结构性修改（主线程）会扩容
+    QVector<quint32> mTypeChangeTicks;
+    // 以 ComponentTypeID 索引的单例组件，未设置的类型为空
+    QVector<std::shared_ptr<void> > mSingletons;
+    // 以 ComponentTypeID 索引的观察者
+    QVector<TypeObservers> mObservers;
+    ObserverID mNextObserverID = 1;
+
+public:
     QVector<QSharedPointer<EntityID> > mEntities;
 
-    EntityID mNextEntityId = 1;
-    QHash<std::type_index, QSharedPointer<IComponentArray> > mComponentArrays;
-    QHash<EntityID, QVector<std::type_index> > mEntityComponentTypes;
+    StorageMode mStorageMode = StorageMode::SparseSet;
+    ArchetypeStorage mArchetypeStorage;
+
+    // 以 ComponentTypeID 直接索引，未使用过的组件类型为空指针
+    QVector<QSharedPointer<IComponentArray> > mComponentArrays;
 };
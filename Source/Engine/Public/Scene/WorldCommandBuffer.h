@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+#include "Scene/World.h"
+
+/*!
+ * 延迟执行的结构变化命令：创建/销毁实体、增删组件
+ * 任意线程都可以录制，每个线程写入自己的录制器，录制器的锁只在回放取走命令时才会竞争；在同步点（SystemManager::updateAll 的批次之间）由主线程统一回放
+ * @note 遍历 view/group/each 时需要增删组件也应通过这里，避免 ComponentArray 交换删除打乱正在遍历的下标
+ */
+class WorldCommandBuffer {
+public:
+    WorldCommandBuffer();
+
+    ~WorldCommandBuffer();
+
+    /**
+     * @brief 录制创建实体。
+     * @return 待定句柄，只能在同一个命令缓冲区中作为后续命令的目标，回放时替换为真正的实体。
+     * 回放只创建已取走的创建命令对应的实体，之后才录制的创建命令连同引用它的命令留到下一次回放；
+     * 句柄在创建它的那次回放和下一次回放中有效，更晚录制的命令会以 INVALID_ENTITY 为目标
+     */
+    EntityID createEntity();
+
+    void destroyEntity(EntityID entity);
+
+    template<typename T>
+    void addComponent(EntityID entity, T component) {
+        record(entity, [component = std::move(component)](World &world, EntityID target) mutable {
+            world.addComponent<T>(target, std::move(component));
+        });
+    }
+
+    template<typename T>
+    void removeComponent(EntityID entity) {
+        record(entity, [](World &world, EntityID target) {
+            world.removeComponent<T>(target);
+        });
+    }
+
+    // 单例的增删会改变 World 的索引表，并行系统需要创建单例时经这里录制
+    template<typename T>
+    void setSingleton(T value) {
+        record(INVALID_ENTITY, [value = std::move(value)](World &world, EntityID) mutable {
+            world.setSingleton<T>(std::move(value));
+        });
+    }
+
+    /**
+     * @brief 回放并清空已录制的命令，同一时间只能有一个线程回放，其他线程可以同时录制。
+     *
+     * 先逐个录制器取走命令，再创建其中所有待定实体，最后按录制器注册顺序、录制器内按录制顺序执行其余命令；
+     * 不同线程录制的命令之间没有顺序保证。
+     */
+    void playback(World &world);
+
+    bool isEmpty() const;
+
+private:
+    // apply 为空的是 createEntity 录制的创建命令，entity 为它的待定句柄
+    struct Command {
+        EntityID entity;
+        std::function<void(World &, EntityID)> apply;
+    };
+
+    // 每个线程独占一个录制器，锁只与回放取走命令时竞争
+    struct Recorder {
+        mutable QMutex mutex;
+        QVector<Command> commands;
+    };
+
+    void record(EntityID entity, std::function<void(World &, EntityID)> apply);
+
+    Recorder &localRecorder();
+
+    // 区分不同的命令缓冲区实例，线程本地缓存以它为键，避免地址复用带来的误命中
+    const quint64 mBufferId;
+
+    // 保护 mRecorders 本身；录制器只增不删，取到的指针在缓冲区销毁前一直有效
+    mutable QMutex mRecordersMutex;
+    std::vector<std::unique_ptr<Recorder> > mRecorders;
+
+    // 待定实体的下标单调递增、不随回放清零，不同批次的待定句柄不会重复
+    std::atomic<quint32> mNextPendingIndex{0};
+
+    // 以下只由回放线程访问：上一次回放创建的实体（供取走之后才录制的后续命令解析），
+    // 以及目标的创建命令还没有被取走、留到下一次回放的命令
+    QHash<quint32, EntityID> mPreviousCreated;
+    QVector<Command> mDeferred;
+};
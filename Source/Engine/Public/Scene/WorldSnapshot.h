@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "Scene/GeometryArena.h"
+#include "Scene/World.h"
+
+/*!
+ * 快照写入器：组件数据按本机字节序追加到 body，字符串统一进入字符串表，只写下标
+ * @note 同一路径在十万个材质中只存一份，读回时这些 QString 也共享同一块内存
+ */
+class SnapshotWriter {
+public:
+    template<typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>, "write() only accepts trivially copyable values");
+        writeRaw(&value, sizeof(T));
+    }
+
+    void writeRaw(const void *data, qsizetype bytes) { mBody.append(static_cast<const char *>(data), bytes); }
+
+    // 元素个数 + 连续数据，一次 memcpy
+    template<typename T>
+    void writeArray(const QVector<T> &values) {
+        write<quint32>(static_cast<quint32>(values.size()));
+        writeRaw(values.constData(), values.size() * static_cast<qsizetype>(sizeof(T)));
+    }
+
+    void writeString(const QString &value);
+
+    // 几何体同样进入几何体表，共享同一个句柄的实体只写一份顶点和索引；无效句柄写 0
+    void writeGeometry(GeometryHandle handle);
+
+    qsizetype position() const { return mBody.size(); }
+
+    // 回填之前写下的占位值，例如块的字节数
+    template<typename T>
+    void patch(qsizetype offset, const T &value) {
+        std::memcpy(mBody.data() + offset, &value, sizeof(T));
+    }
+
+    // 丢弃 position 之后写入的内容
+    void rollback(qsizetype position) { mBody.truncate(position); }
+
+    const QByteArray &body() const { return mBody; }
+    const QVector<QString> &strings() const { return mStrings; }
+    const QVector<GeometryHandle> &geometries() const { return mGeometries; }
+
+private:
+    QByteArray mBody;
+    QHash<QString, quint32> mStringIndices;
+    QVector<QString> mStrings;
+    // 句柄 id -> 表下标 + 1
+    QHash<quint32, quint32> mGeometryIndices;
+    QVector<GeometryHandle> mGeometries;
+};
+
+/*!
+ * 快照读取器，所有读取都做越界检查，失败后 ok() 返回 false 且之后的读取都返回默认值
+ */
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const QByteArray &data) : mData(data) {
+    }
+
+    bool ok() const { return mOk; }
+
+    // 内容校验失败时由调用方标记
+    void fail() { mOk = false; }
+
+    qsizetype position() const { return mPosition; }
+    qsizetype remaining() const { return mData.size() - mPosition; }
+
+    bool readRaw(void *dst, qsizetype bytes);
+
+    bool skip(qsizetype bytes);
+
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "read() only accepts trivially copyable values");
+        T value{};
+        readRaw(&value, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    QVector<T> readArray() {
+        const quint32 count = read<quint32>();
+        if (!mOk || static_cast<quint64>(count) * sizeof(T) > static_cast<quint64>(remaining())) {
+            mOk = false;
+            return {};
+        }
+        QVector<T> values(count);
+        readRaw(values.data(), count * static_cast<qsizetype>(sizeof(T)));
+        return values;
+    }
+
+    QString readString();
+
+    void setStrings(QVector<QString> strings) { mStrings = std::move(strings); }
+
+    // 返回几何体表中对应条目在本进程 GeometryArena 中的句柄
+    GeometryHandle readGeometry();
+
+    void setGeometries(QVector<GeometryHandle> geometries) { mGeometries = std::move(geometries); }
+
+private:
+    const QByteArray &mData;
+    qsizetype mPosition = 0;
+    bool mOk = true;
+    QVector<QString> mStrings;
+    QVector<GeometryHandle> mGeometries;
+};
+
+/*!
+ * World 的二进制快照
+ * 文件布局：[文件头][字符串表][几何体表][实体槽位表][组件块数][组件块 0][组件块 1]...
+ * 每个组件块：[类型名下标][元素大小][实体数组][负载字节数][负载]
+ * 可平凡拷贝的组件整块 memcpy 写出，读回时直接接管为 ComponentArray 的存储；含 QString/QVector 的组件逐字段序列化
+ * @note 组件类型以注册名标识：ComponentTypeID 按首次使用的顺序分配，跨进程不稳定，不能写进文件
+ * @note 几何体表每个条目读回时只在 GeometryArena 中分配一次，共享几何体的实体读回后仍然共享同一个句柄
+ * @note 实体句柄（下标 + 代数）原样恢复，快照里保存的句柄在读回后仍然有效；未注册的组件类型不会被保存
+ */
+class WorldSnapshot {
+public:
+    static WorldSnapshot *getInstance();
+
+    // 注册引擎内置组件
+    WorldSnapshot();
+
+    // 注册可平凡拷贝的组件，按内存布局整块读写，布局改变（大小不同）的旧块在读取时会被跳过
+    template<typename T>
+    void registerComponent(const QString &name);
+
+    // 注册需要逐字段读写的组件
+    template<typename T>
+    void registerComponent(const QString &name, std::function<void(SnapshotWriter &, const T &)> writeFn,
+                           std::function<void(SnapshotReader &, T &)> readFn);
+
+    QByteArray save(const World &world) const;
+
+    /**
+     * @brief 清空 world 并从快照恢复全部实体和组件。
+     * @return 数据损坏时返回 false，此时 world 被清空
+     */
+    bool load(World &world, const QByteArray &data) const;
+
+    bool saveToFile(const World &world, const QString &filePath) const;
+
+    bool loadFromFile(World &world, const QString &filePath) const;
+
+private:
+    struct ComponentSerializer {
+        QString name;
+        // 0 表示逐字段序列化
+        quint32 elementSize = 0;
+        // 写出块的实体数组和负载，没有该组件时返回 false 且不写任何内容
+        std::function<bool(const World &, SnapshotWriter &)> save;
+        std::function<bool(World &, SnapshotReader &, QVector<EntityID>)> load;
+    };
+
+    template<typename T>
+    static QVector<EntityID> collectEntities(const World &world);
+
+    void addSerializer(ComponentSerializer serializer);
+
+    QVector<ComponentSerializer> mSerializers;
+    QHash<QString, qint32> mSerializerByName;
+};
+
+template<typename T>
+QVector<EntityID> WorldSnapshot::collectEntities(const World &world) {
+    QVector<EntityID> entities;
+    world.forEachComponentBlock<T>([&entities](qint32 count, const EntityID *blockEntities, const T *) {
+        const qsizetype offset = entities.size();
+        entities.resize(offset + count);
+        std::memcpy(entities.data() + offset, blockEntities, count * sizeof(EntityID));
+    });
+    return entities;
+}
+
+template<typename T>
+void WorldSnapshot::registerComponent(const QString &name) {
+    static_assert(std::is_trivially_copyable_v<T>, "use the registerComponent overload with read/write functions");
+    ComponentSerializer serializer;
+    serializer.name = name;
+    // 标签组件只有实体列表，负载为空
+    constexpr qsizetype ElementSize = std::is_empty_v<T> ? 0 : sizeof(T);
+    serializer.elementSize = ElementSize;
+    serializer.save = [](const World &world, SnapshotWriter &writer) {
+        const QVector<EntityID> entities = collectEntities<T>(world);
+        if (entities.isEmpty()) return false;
+        writer.writeArray(entities);
+        writer.write<quint64>(static_cast<quint64>(entities.size()) * ElementSize);
+        if constexpr (ElementSize > 0) {
+            world.forEachComponentBlock<T>([&writer](qint32 count, const EntityID *, const T *components) {
+                writer.writeRaw(components, count * ElementSize);
+            });
+        }
+        return true;
+    };
+    serializer.load = [](World &world, SnapshotReader &reader, QVector<EntityID> entities) {
+        QVector<T> components(entities.size());
+        if (!reader.readRaw(components.data(), components.size() * ElementSize)) return false;
+        world.insertComponents<T>(entities, std::move(components));
+        return true;
+    };
+    addSerializer(std::move(serializer));
+}
+
+template<typename T>
+void WorldSnapshot::registerComponent(const QString &name, std::function<void(SnapshotWriter &, const T &)> writeFn,
+                                      std::function<void(SnapshotReader &, T &)> readFn) {
+    ComponentSerializer serializer;
+    serializer.name = name;
+    serializer.save = [writeFn](const World &world, SnapshotWriter &writer) {
+        const QVector<EntityID> entities = collectEntities<T>(world);
+        if (entities.isEmpty()) return false;
+        writer.writeArray(entities);
+        const qsizetype sizeOffset = writer.position();
+        writer.write<quint64>(0);
+        world.forEachComponentBlock<T>([&](qint32 count, const EntityID *, const T *components) {
+            for (qint32 i = 0; i < count; ++i) {
+                writeFn(writer, components[i]);
+            }
+        });
+        writer.patch<quint64>(sizeOffset, writer.position() - sizeOffset - sizeof(quint64));
+        return true;
+    };
+    serializer.load = [readFn](World &world, SnapshotReader &reader, QVector<EntityID> entities) {
+        QVector<T> components(entities.size());
+        for (T &component: components) {
+            readFn(reader, component);
+        }
+        if (!reader.ok()) return false;
+        world.insertComponents<T>(entities, std::move(components));
+        return true;
+    };
+    addSerializer(std::move(serializer));
+}
@@ -6,5 +6,7 @@ class World;
 
 class CameraSystem : public ISystem {
     void update(World *world, float deltaTime) override;
+
+    SystemAccess access() const override;
 };
 
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ECSCore.h"
+#include "Interface/ISystem.h"
+
+class World;
+class QVector3D;
+
+/*!
+ * 维护 SpatialIndexSingleton：把带 Transform 的实体按世界坐标位置放进空间哈希网格
+ * 每帧只重新放置世界矩阵（或没有世界矩阵时的本地 Transform）被写过的实体；有实体或组件增删时再检查一遍失效的实体
+ * @note 需要放在 TransformSystem 之后，读取的是本帧传播完的世界矩阵；与 TransformSystem 的独占访问冲突，调度会保持这个顺序
+ * @note 单例不存在（首次运行或 World::clear 之后）时经命令缓冲区创建，下一次更新全量重建，update 本身不做结构性修改
+ */
+class SpatialIndexSystem : public ISystem {
+public:
+    explicit SpatialIndexSystem(float cellSize = 4.0f);
+
+    void update(World *world, float deltaTime) override;
+
+    SystemAccess access() const override;
+
+    // 实体当前的世界坐标位置，没有 Transform 时返回 false
+    static bool worldPosition(const World &world, EntityID entity, QVector3D &position);
+
+private:
+    float mCellSize;
+    quint32 mLastTick = 0;
+};
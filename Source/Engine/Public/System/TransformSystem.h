@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QVector>
+
+#include "ECSCore.h"
+#include "Interface/ISystem.h"
+#include "Scene/TransformSoA.h"
+
+class World;
+struct WorldTransformComponent;
+
+/*!
+ * 层级变换传播：把 TransformComponent 的本地矩阵沿 HierarchyComponent 组成的树乘到 WorldTransformComponent
+ * 只处理本帧被写过的 Transform/Hierarchy 及其子树，按深度逐层广度优先展开，每层内的节点互不依赖，在 JobSystem 上并行计算
+ * @note 移动一个带 1 万个子节点的模型只需写一次根节点的 Transform，传播是对这棵子树的一次线性遍历
+ * @note 会给缺少 WorldTransformComponent 的实体补上该组件，属于结构性修改，因此不声明读写集合，保留默认的独占访问、不参与并行批次
+ */
+class TransformSystem : public ISystem {
+public:
+    void update(World *world, float deltaTime) override;
+
+    /**
+     * @brief 设置父节点，parent 为 INVALID_ENTITY 时变为根节点。
+     * @return parent 是 child 自身或其后代（会形成环）时返回 false，不做修改
+     */
+    static bool setParent(World &world, EntityID child, EntityID parent);
+
+private:
+    // 结构或父子关系变化后重建子节点表和深度，父节点发生变化的实体追加到 dirty
+    void rebuildHierarchy(World *world, QVector<EntityID> &dirty);
+
+    struct PropagateItem {
+        const WorldTransformComponent *parentWorld;
+        WorldTransformComponent *world;
+    };
+
+    quint32 mLastTick = 0;
+
+    // 以 entityIndex 索引：子节点在 mChildren 中的区间 [mChildOffsets[i], mChildOffsets[i + 1])
+    QVector<qint32> mChildOffsets;
+    QVector<EntityID> mChildren;
+    // 以 entityIndex 索引：有效的父节点（已销毁的父节点记为 INVALID_ENTITY）和深度，不在任何树上（环）的节点深度为 -1
+    QVector<EntityID> mParents;
+    QVector<qint32> mDepths;
+    qint32 mMaxDepth = 0;
+
+    // 以 entityIndex 索引的访问标记，每次传播递增 mVisitEpoch，不必清空数组
+    QVector<quint32> mVisited;
+    quint32 mVisitEpoch = 0;
+
+    QVector<QVector<EntityID> > mDirtyByDepth;
+    QVector<PropagateItem> mLevel;
+    // 与 mLevel 一一对应的本地 TRS，由 TransformSoA 的 SIMD 内核成批合成本地矩阵
+    TransformSoA mLocals;
+};